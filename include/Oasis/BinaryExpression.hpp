@@ -6,13 +6,21 @@
 #define OASIS_BINARYEXPRESSION_HPP
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <functional>
-#include <list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
 
+#include "CanonicalOrder.hpp"
 #include "Expression.hpp"
+#include "Hash.hpp"
 #include "Oasis/SimplifyVisitor.hpp"
 #include "RecursiveCast.hpp"
+#include "Substitute.hpp"
+#include "Variable.hpp"
 #include "Visit.hpp"
 
 namespace Oasis {
@@ -32,36 +40,80 @@ template <template <typename, typename> typename T>
 concept IAssociativeAndCommutative = IExpression<T<Expression, Expression>> && ((T<Expression, Expression>::GetStaticCategory() & (Associative | Commutative)) == (Associative | Commutative));
 
 /**
- * Builds a reasonably balanced binary expression from a vector of operands.
+ * The shape of the binary view of an n-ary expression.
+ */
+enum class TreeShape {
+    Balanced, ///< The operands are split at the largest power of two less than their count, e.g. `(a + b) + (c + d)`.
+    LeftLeaning, ///< The operands are grouped from the left, e.g. `((a + b) + c) + d`.
+};
+
+/**
+ * Builds an expression from a vector of operands, storing them contiguously.
+ * @note This function is not intended to be used directly by end users.
+ *
  * @tparam T The type of the binary expression, e.g. Add or Multiply.
  * @param ops The vector of operands. Must have a minimum of 2 operands.
- * @return A binary expression with the operands in the vector, or a nullptr if ops.size() <=1.
+ * @param shape The shape of the binary view of the expression.
+ * @return A binary expression with the operands in the vector.
+ */
+template <template <typename, typename> typename T>
+    requires IAssociativeAndCommutative<T>
+auto BuildFromOperands(std::vector<std::shared_ptr<const Expression>>&& ops, TreeShape shape) -> std::unique_ptr<T<Expression, Expression>>
+{
+    using GeneralizedT = T<Expression, Expression>;
+    static_assert(std::constructible_from<GeneralizedT, std::vector<std::shared_ptr<const Expression>>, TreeShape>, "Associative and commutative expressions must support n-ary storage");
+
+    return std::make_unique<GeneralizedT>(std::move(ops), shape);
+}
+
+/**
+ * Builds an n-ary expression from a vector of operands, taking ownership of them.
+ *
+ * The operands are moved into a single contiguous node, so no operand is copied.
+ * @tparam T The type of the binary expression, e.g. Add or Multiply.
+ * @param ops The vector of operands. Must have a minimum of 2 operands.
+ * @param shape The shape of the binary view of the expression.
+ * @return A binary expression with the operands in the vector, or a nullptr if ops.size() <=1, in
+ * which case ops is left untouched.
  */
 template <template <typename, typename> typename T>
     requires IAssociativeAndCommutative<T>
-auto BuildFromVector(const std::vector<std::unique_ptr<Expression>>& ops) -> std::unique_ptr<T<Expression, Expression>>
+auto BuildFromVector(std::vector<std::unique_ptr<Expression>>&& ops, TreeShape shape = TreeShape::Balanced) -> std::unique_ptr<T<Expression, Expression>>
 {
     if (ops.size() <= 1) {
         return nullptr;
     }
 
-    using GeneralizedT = T<Expression, Expression>;
+    std::vector<std::shared_ptr<const Expression>> operands;
+    operands.reserve(ops.size());
 
-    std::list<std::unique_ptr<Expression>> opsList;
-    opsList.resize(ops.size());
+    std::move(ops.begin(), ops.end(), std::back_inserter(operands));
+    ops.clear();
 
-    std::transform(ops.begin(), ops.end(), opsList.begin(), [](const auto& op) { return op->Copy(); });
+    return BuildFromOperands<T>(std::move(operands), shape);
+}
 
-    while (std::next(opsList.begin()) != opsList.end()) {
-        for (auto i = opsList.begin(); i != opsList.end() && std::next(i) != opsList.end();) {
-            auto node = std::make_unique<GeneralizedT>(**i, **std::next(i));
-            opsList.insert(i, std::move(node));
-            i = opsList.erase(i, std::next(i, 2));
-        }
+/**
+ * Builds an n-ary expression from a vector of operands, copying each of them once.
+ * @tparam T The type of the binary expression, e.g. Add or Multiply.
+ * @param ops The vector of operands. Must have a minimum of 2 operands.
+ * @param shape The shape of the binary view of the expression.
+ * @return A binary expression with the operands in the vector, or a nullptr if ops.size() <=1.
+ */
+template <template <typename, typename> typename T>
+    requires IAssociativeAndCommutative<T>
+auto BuildFromVector(const std::vector<std::unique_ptr<Expression>>& ops, TreeShape shape = TreeShape::Balanced) -> std::unique_ptr<T<Expression, Expression>>
+{
+    if (ops.size() <= 1) {
+        return nullptr;
     }
 
-    auto* result = dynamic_cast<GeneralizedT*>(opsList.front().release());
-    return std::unique_ptr<GeneralizedT>(result);
+    std::vector<std::shared_ptr<const Expression>> operands;
+    operands.reserve(ops.size());
+
+    std::transform(ops.begin(), ops.end(), std::back_inserter(operands), [](const auto& op) { return std::shared_ptr<const Expression> { op->Copy() }; });
+
+    return BuildFromOperands<T>(std::move(operands), shape);
 }
 
 /**
@@ -73,6 +125,11 @@ auto BuildFromVector(const std::vector<std::unique_ptr<Expression>>& ops) -> std
  * two template parameters, the types of the most significant and least significant operands, respectively.
  * This class uses a [Curiously Recurring Template Pattern](https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern)
  *
+ * Generalized associative and commutative expressions, such as `Add<Expression, Expression>`, may
+ * also hold any number of operands in a contiguous vector. The most and least significant operands
+ * of such an expression are then a view of that vector, shaped by a TreeShape, and are only created
+ * when they are first accessed.
+ *
  * @note This class is not intended to be used directly by end users.
  *
  * @tparam DerivedT The derived class.
@@ -86,16 +143,21 @@ class BinaryExpression : public Expression {
     using DerivedGeneralized = DerivedT<Expression, Expression>;
 
 public:
-    BinaryExpression() = default;
-    BinaryExpression(const BinaryExpression& other)
+    BinaryExpression()
     {
-        if (other.HasMostSigOp()) {
-            SetMostSigOp(other.GetMostSigOp());
-        }
+        UpdateHash();
+    }
 
-        if (other.HasLeastSigOp()) {
-            SetLeastSigOp(other.GetLeastSigOp());
-        }
+    /**
+     * Copies an expression. The copy shares the operands of the other expression.
+     */
+    BinaryExpression(const BinaryExpression& other)
+        : Expression(other)
+        , mostSigOp(other.mostSigOp)
+        , leastSigOp(other.leastSigOp)
+        , range(other.range)
+        , hash(other.hash)
+    {
     }
 
     BinaryExpression(const MostSigOpT& mostSigOp, const LeastSigOpT& leastSigOp)
@@ -104,24 +166,38 @@ public:
         SetLeastSigOp(leastSigOp);
     }
 
-    template <IExpression Op1T, IExpression Op2T, IExpression... OpsT>
-    BinaryExpression(const Op1T& op1, const Op2T& op2, const OpsT&... ops)
+    /**
+     * Constructs an n-ary expression from a list of operands. Temporary operands are moved into the
+     * expression rather than copied.
+     */
+    template <typename Op1T, typename Op2T, typename... OpsT>
+        requires IExpression<std::remove_cvref_t<Op1T>> && IExpression<std::remove_cvref_t<Op2T>> && (IExpression<std::remove_cvref_t<OpsT>> && ...) && IAssociativeAndCommutative<DerivedT>
+    BinaryExpression(Op1T&& op1, Op2T&& op2, OpsT&&... ops)
     {
-        static_assert(IAssociativeAndCommutative<DerivedT>, "List initializer only supported for associative and commutative expressions");
         static_assert(std::is_same_v<DerivedGeneralized, DerivedSpecialized>, "List initializer only supported for generalized expressions");
 
-        std::vector<std::unique_ptr<Expression>> opsVec;
+        std::vector<std::shared_ptr<const Expression>> opsVec;
+        opsVec.reserve(sizeof...(OpsT) + 2);
 
-        for (auto opWrapper : std::vector<std::reference_wrapper<const Expression>> { static_cast<const Expression&>(op1), static_cast<const Expression&>(op2), (static_cast<const Expression&>(ops))... }) {
-            const Expression& operand = opWrapper.get();
-            opsVec.emplace_back(operand.Copy());
-        }
+        opsVec.push_back(ShareOperand(std::forward<Op1T>(op1)));
+        opsVec.push_back(ShareOperand(std::forward<Op2T>(op2)));
+        (opsVec.push_back(ShareOperand(std::forward<OpsT>(ops))), ...);
 
-        // build expression from vector
-        auto generalized = BuildFromVector<DerivedT>(opsVec);
+        AssignOperands(std::move(opsVec), TreeShape::Balanced);
+    }
+
+    /**
+     * Constructs an n-ary expression that stores its operands contiguously.
+     * @param ops The operands of the expression. Must have a minimum of 2 operands.
+     * @param shape The shape of the binary view of the expression.
+     */
+    explicit BinaryExpression(std::vector<std::shared_ptr<const Expression>> ops, TreeShape shape = TreeShape::Balanced)
+    {
+        static_assert(IAssociativeAndCommutative<DerivedT>, "N-ary storage only supported for associative and commutative expressions");
+        static_assert(std::is_same_v<DerivedGeneralized, DerivedSpecialized>, "N-ary storage only supported for generalized expressions");
+        assert(ops.size() >= 2);
 
-        SetLeastSigOp(generalized->GetLeastSigOp());
-        SetMostSigOp(generalized->GetMostSigOp());
+        AssignOperands(std::move(ops), shape);
     }
 
     [[nodiscard]] auto Copy() const -> std::unique_ptr<Expression> final
@@ -135,7 +211,7 @@ public:
     }
     [[nodiscard]] auto Equals(const Expression& other) const -> bool final
     {
-        if (this->GetType() != other.GetType()) {
+        if (this->GetType() != other.GetType() || this->Hash() != other.Hash()) {
             return false;
         }
 
@@ -145,8 +221,8 @@ public:
         bool mostSigOpMismatch = false, leastSigOpMismatch = false;
 
         if (this->HasMostSigOp() == otherBinaryGeneralized.HasMostSigOp()) {
-            if (mostSigOp && otherBinaryGeneralized.HasMostSigOp()) {
-                mostSigOpMismatch = !mostSigOp->Equals(otherBinaryGeneralized.GetMostSigOp());
+            if (this->HasMostSigOp() && otherBinaryGeneralized.HasMostSigOp()) {
+                mostSigOpMismatch = !GetMostSigOp().Equals(otherBinaryGeneralized.GetMostSigOp());
             }
         } else {
             mostSigOpMismatch = true;
@@ -154,10 +230,10 @@ public:
 
         if (this->HasLeastSigOp() == otherBinaryGeneralized.HasLeastSigOp()) {
             if (this->HasLeastSigOp() && otherBinaryGeneralized.HasLeastSigOp()) {
-                leastSigOpMismatch = !leastSigOp->Equals(otherBinaryGeneralized.GetLeastSigOp());
+                leastSigOpMismatch = !GetLeastSigOp().Equals(otherBinaryGeneralized.GetLeastSigOp());
             }
         } else {
-            mostSigOpMismatch = true;
+            leastSigOpMismatch = true;
         }
 
         if (!mostSigOpMismatch && !leastSigOpMismatch) {
@@ -168,37 +244,38 @@ public:
             return false;
         }
 
-        auto thisFlattened = std::vector<std::unique_ptr<Expression>> {};
-        auto otherFlattened = std::vector<std::unique_ptr<Expression>> {};
+        auto thisFlattened = this->FlattenView();
+        auto otherFlattened = otherBinaryGeneralized.FlattenView();
 
-        this->Flatten(thisFlattened);
-        otherBinaryGeneralized.Flatten(otherFlattened);
-
-        for (const auto& thisOperand : thisFlattened) {
-            if (std::find_if(otherFlattened.begin(), otherFlattened.end(), [&thisOperand](const auto& otherOperand) {
-                    return thisOperand->Equals(*otherOperand);
-                })
-                == otherFlattened.end()) {
-                return false;
-            }
+        if (thisFlattened.size() != otherFlattened.size()) {
+            return false;
         }
 
-        return true;
+        // Operands that are equal are equivalent under the canonical order, so sorting both sides
+        // lines them up and the multisets of operands can be compared with a linear merge.
+        std::ranges::sort(thisFlattened, CanonicalLess {});
+        std::ranges::sort(otherFlattened, CanonicalLess {});
+
+        return std::ranges::equal(thisFlattened, otherFlattened, [](const Expression* thisOperand, const Expression* otherOperand) {
+            return thisOperand->Equals(*otherOperand);
+        });
     }
 
     [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression> final
     {
-        DerivedGeneralized generalized;
-
-        if (this->mostSigOp) {
-            generalized.SetMostSigOp(*this->mostSigOp->Copy());
-        }
-
-        if (this->leastSigOp) {
-            generalized.SetLeastSigOp(*this->leastSigOp->Copy());
+        if constexpr (std::same_as<DerivedSpecialized, DerivedGeneralized>) {
+            return Copy();
+        } else {
+            auto generalized = std::make_unique<DerivedGeneralized>();
+            generalized->SetMostSigOp(std::shared_ptr<const Expression> { this->mostSigOp });
+            generalized->SetLeastSigOp(std::shared_ptr<const Expression> { this->leastSigOp });
+            return generalized;
         }
+    }
 
-        return std::make_unique<DerivedGeneralized>(generalized);
+    [[nodiscard]] auto Hash() const -> std::size_t final
+    {
+        return hash;
     }
 
     [[nodiscard]] auto Integrate(const Expression& integrationVariable) const -> std::unique_ptr<Expression> override
@@ -217,7 +294,7 @@ public:
 
         if (this->HasMostSigOp() == otherBinaryGeneralized.HasMostSigOp()) {
             if (this->HasMostSigOp() && otherBinaryGeneralized.HasMostSigOp()) {
-                if (!mostSigOp->StructurallyEquivalent(otherBinaryGeneralized.GetMostSigOp())) {
+                if (!GetMostSigOp().StructurallyEquivalent(otherBinaryGeneralized.GetMostSigOp())) {
                     return false;
                 }
             }
@@ -225,7 +302,7 @@ public:
 
         if (this->HasLeastSigOp() == otherBinaryGeneralized.HasLeastSigOp()) {
             if (this->HasLeastSigOp() && otherBinaryGeneralized.HasLeastSigOp()) {
-                if (!leastSigOp->StructurallyEquivalent(otherBinaryGeneralized.GetLeastSigOp())) {
+                if (!GetLeastSigOp().StructurallyEquivalent(otherBinaryGeneralized.GetLeastSigOp())) {
                     return false;
                 }
             }
@@ -247,24 +324,102 @@ public:
      */
     auto Flatten(std::vector<std::unique_ptr<Expression>>& out) const -> void
     {
-        if (mostSigOp) {
-            if (this->mostSigOp->template Is<DerivedGeneralized>()) {
-                auto generalizedMostSigOp = this->mostSigOp->Generalize();
-                const auto& mostSigOp = static_cast<const DerivedGeneralized&>(*generalizedMostSigOp);
-                mostSigOp.Flatten(out);
+        ForEachFlattened([&out](const Expression& op) { out.push_back(op.Copy()); });
+    }
+
+    /**
+     * Flattens this expression without copying its operands.
+     *
+     * @return Pointers to the operands of this expression, in the order Flatten would copy them. The
+     * pointers are valid for as long as this expression is.
+     */
+    [[nodiscard]] auto FlattenView() const -> std::vector<const Expression*>
+    {
+        std::vector<const Expression*> out;
+        ForEachFlattened([&out](const Expression& op) { out.push_back(&op); });
+        return out;
+    }
+
+    /**
+     * Flattens this expression into shared operands, for callers that need ownership of the operands.
+     *
+     * Operands are immutable, so sharing them rather than moving them out leaves this expression
+     * intact and still copies nothing.
+     * @param out The vector to append the operands to.
+     */
+    auto FlattenShared(std::vector<std::shared_ptr<const Expression>>& out) const -> void
+    {
+        const auto flattenOperand = [&out](const std::shared_ptr<const Expression>& op) {
+            if (!op->template Is<DerivedGeneralized>()) {
+                out.push_back(op);
+            } else if (auto generalizedOp = std::dynamic_pointer_cast<const DerivedGeneralized>(op); generalizedOp) {
+                generalizedOp->FlattenShared(out);
             } else {
-                out.push_back(this->mostSigOp->Copy());
+                // Generalizing a specialized expression shares its operands.
+                auto specializedOp = op->Generalize();
+                static_cast<const DerivedGeneralized&>(*specializedOp).FlattenShared(out);
+            }
+        };
+
+        if (range) {
+            for (std::size_t i = range->begin; i < range->end; ++i) {
+                flattenOperand((*range->operands)[i]);
             }
+            return;
+        }
+
+        if (mostSigOp) {
+            flattenOperand(mostSigOp);
         }
 
         if (leastSigOp) {
-            if (this->leastSigOp->template Is<DerivedGeneralized>()) {
-                auto generalizedLeastSigOp = this->leastSigOp->Generalize();
-                const auto& leastSigOp = static_cast<const DerivedGeneralized&>(*generalizedLeastSigOp);
-                leastSigOp.Flatten(out);
-            } else {
-                out.push_back(this->leastSigOp->Copy());
+            flattenOperand(leastSigOp);
+        }
+    }
+
+    /**
+     * Invokes a function on each operand of this expression, in the order Flatten would copy them,
+     * without copying or allocating.
+     * @param fn The function to invoke with each operand as a `const Expression&`.
+     */
+    template <typename FnT>
+    auto ForEachFlattened(FnT&& fn) const -> void
+    {
+        // The operands of an n-ary expression are already contiguous, so its view is not walked.
+        if (range) {
+            for (std::size_t i = range->begin; i < range->end; ++i) {
+                ForEachFlattenedOperand(*(*range->operands)[i], fn);
             }
+            return;
+        }
+
+        if (mostSigOp) {
+            ForEachFlattenedOperand(*mostSigOp, fn);
+        }
+
+        if (leastSigOp) {
+            ForEachFlattenedOperand(*leastSigOp, fn);
+        }
+    }
+
+    /**
+     * Gets the number of operands this expression stores contiguously.
+     * @return The number of operands of an n-ary expression, or 2 for a binary expression.
+     */
+    [[nodiscard]] auto GetOperandCount() const -> std::size_t
+    {
+        return range ? range->end - range->begin : 2;
+    }
+
+    [[nodiscard]] auto GetOperandAt(std::size_t index) const -> const Expression* final
+    {
+        switch (index) {
+        case 0:
+            return MostSigOpPtr().get();
+        case 1:
+            return LeastSigOpPtr().get();
+        default:
+            return nullptr;
         }
     }
 
@@ -274,8 +429,8 @@ public:
      */
     auto GetMostSigOp() const -> const MostSigOpT&
     {
-        assert(mostSigOp != nullptr);
-        return *mostSigOp;
+        assert(HasMostSigOp());
+        return *MostSigOpPtr();
     }
 
     /**
@@ -284,8 +439,26 @@ public:
      */
     auto GetLeastSigOp() const -> const LeastSigOpT&
     {
-        assert(leastSigOp != nullptr);
-        return *leastSigOp;
+        assert(HasLeastSigOp());
+        return *LeastSigOpPtr();
+    }
+
+    /**
+     * Gets the most significant operand of this expression without copying it.
+     * @return A shared pointer to the most significant operand, or nullptr if it is not set.
+     */
+    auto GetMostSigOpPtr() const -> std::shared_ptr<const MostSigOpT>
+    {
+        return MostSigOpPtr();
+    }
+
+    /**
+     * Gets the least significant operand of this expression without copying it.
+     * @return A shared pointer to the least significant operand, or nullptr if it is not set.
+     */
+    auto GetLeastSigOpPtr() const -> std::shared_ptr<const LeastSigOpT>
+    {
+        return LeastSigOpPtr();
     }
 
     /**
@@ -294,7 +467,7 @@ public:
      */
     [[nodiscard]] auto HasMostSigOp() const -> bool
     {
-        return mostSigOp != nullptr;
+        return range != nullptr || mostSigOp != nullptr;
     }
 
     /**
@@ -303,7 +476,7 @@ public:
      */
     [[nodiscard]] auto HasLeastSigOp() const -> bool
     {
-        return leastSigOp != nullptr;
+        return range != nullptr || leastSigOp != nullptr;
     }
 
     /**
@@ -314,24 +487,54 @@ public:
         requires IsAnyOf<T, MostSigOpT, Expression>
     auto SetMostSigOp(const T& op) -> bool
     {
+        DetachOperands();
+
         if constexpr (std::same_as<MostSigOpT, Expression>) {
             this->mostSigOp = op.Copy();
+            UpdateHash();
             return true;
         }
 
         if constexpr (std::same_as<MostSigOpT, T> && !std::same_as<MostSigOpT, Expression>) {
-            this->mostSigOp = std::make_unique<MostSigOpT>(op);
+            this->mostSigOp = std::make_shared<MostSigOpT>(op);
+            UpdateHash();
             return true;
         }
 
         if (auto castedOp = Oasis::RecursiveCast<MostSigOpT>(op); castedOp) {
             mostSigOp = std::move(castedOp);
+            UpdateHash();
             return true;
         }
 
         return false;
     }
 
+    /**
+     * Sets the most significant operand of this expression, sharing it rather than copying it.
+     * @param op The operand to share.
+     */
+    template <typename T>
+        requires IsAnyOf<T, MostSigOpT, Expression>
+    auto SetMostSigOp(std::shared_ptr<const T> op) -> bool
+    {
+        DetachOperands();
+
+        if constexpr (std::same_as<MostSigOpT, Expression> || std::same_as<MostSigOpT, T>) {
+            this->mostSigOp = std::move(op);
+            UpdateHash();
+            return true;
+        } else {
+            if (auto sharedOp = std::dynamic_pointer_cast<const MostSigOpT>(op); sharedOp) {
+                this->mostSigOp = std::move(sharedOp);
+                UpdateHash();
+                return true;
+            }
+
+            return SetMostSigOp(*op);
+        }
+    }
+
     /**
      * Sets the least significant operand of this expression.
      * @param op The operand to set.
@@ -340,37 +543,62 @@ public:
         requires IsAnyOf<T, LeastSigOpT, Expression>
     auto SetLeastSigOp(const T& op) -> bool
     {
+        DetachOperands();
+
         if constexpr (std::same_as<LeastSigOpT, Expression>) {
             this->leastSigOp = op.Copy();
+            UpdateHash();
             return true;
         }
 
         if constexpr (std::same_as<LeastSigOpT, T> && !std::same_as<LeastSigOpT, Expression>) {
-            this->leastSigOp = std::make_unique<LeastSigOpT>(op);
+            this->leastSigOp = std::make_shared<LeastSigOpT>(op);
+            UpdateHash();
             return true;
         }
 
         if (auto castedOp = Oasis::RecursiveCast<LeastSigOpT>(op); castedOp) {
             leastSigOp = std::move(castedOp);
+            UpdateHash();
             return true;
         }
 
         return false;
     }
 
+    /**
+     * Sets the least significant operand of this expression, sharing it rather than copying it.
+     * @param op The operand to share.
+     */
+    template <typename T>
+        requires IsAnyOf<T, LeastSigOpT, Expression>
+    auto SetLeastSigOp(std::shared_ptr<const T> op) -> bool
+    {
+        DetachOperands();
+
+        if constexpr (std::same_as<LeastSigOpT, Expression> || std::same_as<LeastSigOpT, T>) {
+            this->leastSigOp = std::move(op);
+            UpdateHash();
+            return true;
+        } else {
+            if (auto sharedOp = std::dynamic_pointer_cast<const LeastSigOpT>(op); sharedOp) {
+                this->leastSigOp = std::move(sharedOp);
+                UpdateHash();
+                return true;
+            }
+
+            return SetLeastSigOp(*op);
+        }
+    }
+
     auto Substitute(const Expression& var, const Expression& val) -> std::unique_ptr<Expression> override
     {
-        // TODO: FIX WITH VISITOR?
-        std::unique_ptr<Expression> left = ((GetMostSigOp()).Copy())->Substitute(var, val);
-        std::unique_ptr<Expression> right = ((GetLeastSigOp().Copy())->Substitute(var, val));
-        DerivedT<Expression, Expression> comb = DerivedT<Expression, Expression> { *left, *right };
+        if (!var.Is<Variable>()) {
+            throw std::invalid_argument("Variable was not a variable.");
+        }
 
         Oasis::SimplifyVisitor simplifyVisitor {};
-        auto simplified = comb.Accept(simplifyVisitor);
-        if (!simplified) {
-            return comb.Generalize();
-        }
-        return std::move(simplified.value());
+        return Oasis::Substitute(*this, { { static_cast<const Variable&>(var).GetName(), &val } }, simplifyVisitor);
     }
     /**
      * Swaps the operands of this expression.
@@ -378,20 +606,252 @@ public:
      */
     auto SwapOperands() const -> DerivedT<LeastSigOpT, MostSigOpT>
     {
-        return DerivedT { *this->leastSigOp, *this->mostSigOp };
+        DerivedT<LeastSigOpT, MostSigOpT> swapped;
+        swapped.SetMostSigOp(LeastSigOpPtr());
+        swapped.SetLeastSigOp(MostSigOpPtr());
+        return swapped;
     }
 
     auto operator=(const BinaryExpression& other) -> BinaryExpression& = default;
 
     auto AcceptInternal(Visitor& visitor) const -> any override
     {
-        const auto generalized = Generalize();
-        const auto& derivedGeneralized = dynamic_cast<const DerivedGeneralized&>(*generalized);
-        return visitor.Visit(derivedGeneralized);
+        return WithGeneralized([&visitor](const DerivedGeneralized& generalized) { return visitor.Visit(generalized); });
+    }
+
+    auto AcceptInternal(TypedVisitorBase& visitor) const -> void override
+    {
+        WithGeneralized([&visitor](const DerivedGeneralized& generalized) { visitor.Dispatch(generalized); });
+    }
+
+    // Operands are immutable and may be shared with other expressions, so copying an expression
+    // only copies these pointers. Both are null for an expression of more than two operands, whose
+    // view is only reachable through GetMostSigOp and GetLeastSigOp.
+    std::shared_ptr<const MostSigOpT> mostSigOp;
+    std::shared_ptr<const LeastSigOpT> leastSigOp;
+
+private:
+    /**
+     * A range of the contiguous operands of an n-ary expression, along with its lazily created
+     * binary view. Ranges over the same operands share the operands and their hashes.
+     */
+    struct OperandRange {
+        OperandRange(std::shared_ptr<const std::vector<std::shared_ptr<const Expression>>> operands, std::shared_ptr<const std::vector<std::size_t>> prefixHashes, std::size_t begin, std::size_t end, TreeShape shape)
+            : operands(std::move(operands))
+            , prefixHashes(std::move(prefixHashes))
+            , begin(begin)
+            , end(end)
+            , shape(shape)
+        {
+        }
+
+        std::shared_ptr<const std::vector<std::shared_ptr<const Expression>>> operands;
+
+        // prefixHashes[i] is the sum of the hash contributions of the first i operands.
+        std::shared_ptr<const std::vector<std::size_t>> prefixHashes;
+
+        std::size_t begin;
+        std::size_t end;
+        TreeShape shape;
+
+        mutable std::once_flag viewFlag;
+        mutable std::shared_ptr<const Expression> mostSigOp;
+        mutable std::shared_ptr<const Expression> leastSigOp;
+    };
+
+    template <typename FnT>
+    static auto ForEachFlattenedOperand(const Expression& op, FnT& fn) -> void
+    {
+        if (!op.template Is<DerivedGeneralized>()) {
+            fn(op);
+        } else if (const auto* generalizedOp = dynamic_cast<const DerivedGeneralized*>(&op); generalizedOp) {
+            generalizedOp->ForEachFlattened(fn);
+        } else {
+            // A specialized expression of the same type, such as Add<Real, Variable>, is always binary.
+            for (std::size_t i = 0; i < 2; ++i) {
+                if (const Expression* child = op.GetOperandAt(i); child) {
+                    ForEachFlattenedOperand(*child, fn);
+                }
+            }
+        }
+    }
+
+    /**
+     * Gets the contribution of an operand to the hash of an associative expression.
+     *
+     * Operands of the same type contribute their own sums, so the hash is invariant under
+     * regrouping.
+     */
+    static auto HashContribution(const Expression& op) -> std::size_t
+    {
+        const std::size_t seed = HashType(DerivedGeneralized::GetStaticType());
+        return op.template Is<DerivedGeneralized>() ? op.Hash() - seed : HashMix(op.Hash());
+    }
+
+    /**
+     * Shares an operand of the list initializer, moving it if it is a temporary of a concrete type.
+     */
+    template <typename OpT>
+    static auto ShareOperand(OpT&& op) -> std::shared_ptr<const Expression>
+    {
+        using OperandT = std::remove_cvref_t<OpT>;
+
+        if constexpr (std::is_rvalue_reference_v<OpT&&> && !std::is_abstract_v<OperandT>) {
+            return std::make_shared<const OperandT>(std::move(op));
+        } else {
+            return op.Copy();
+        }
+    }
+
+    /**
+     * Makes this expression an n-ary expression over the given operands. Two operands are stored
+     * directly, as in any other binary expression.
+     * @param ops The operands of the expression. Must have a minimum of 2 operands.
+     * @param shape The shape of the binary view of the expression.
+     */
+    auto AssignOperands(std::vector<std::shared_ptr<const Expression>>&& ops, TreeShape shape) -> void
+    {
+        if (ops.size() == 2) {
+            range.reset();
+            mostSigOp = std::move(ops[0]);
+            leastSigOp = std::move(ops[1]);
+            UpdateHash();
+            return;
+        }
+
+        std::vector<std::size_t> prefixHashes(ops.size() + 1, 0);
+        for (std::size_t i = 0; i < ops.size(); ++i) {
+            prefixHashes[i + 1] = prefixHashes[i] + HashContribution(*ops[i]);
+        }
+
+        const std::size_t count = ops.size();
+        AssignRange(std::make_shared<const std::vector<std::shared_ptr<const Expression>>>(std::move(ops)), std::make_shared<const std::vector<std::size_t>>(std::move(prefixHashes)), 0, count, shape);
+    }
+
+    auto AssignRange(std::shared_ptr<const std::vector<std::shared_ptr<const Expression>>> ops, std::shared_ptr<const std::vector<std::size_t>> prefixHashes, std::size_t begin, std::size_t end, TreeShape shape) -> void
+    {
+        mostSigOp.reset();
+        leastSigOp.reset();
+        hash = HashType(DerivedGeneralized::GetStaticType()) + ((*prefixHashes)[end] - (*prefixHashes)[begin]);
+        range = std::make_shared<const OperandRange>(std::move(ops), std::move(prefixHashes), begin, end, shape);
+    }
+
+    /**
+     * Gets the node representing a range of the operands of this n-ary expression, which is the
+     * operand itself if the range only holds one.
+     */
+    static auto MakeRangeNode(const OperandRange& parent, std::size_t begin, std::size_t end) -> std::shared_ptr<const Expression>
+    {
+        if (end - begin == 1) {
+            return (*parent.operands)[begin];
+        }
+
+        auto node = std::make_shared<DerivedGeneralized>();
+        static_cast<BinaryExpression&>(*node).AssignRange(parent.operands, parent.prefixHashes, begin, end, parent.shape);
+        return node;
+    }
+
+    /**
+     * Gets the binary view of this n-ary expression, creating it on first access. This only creates
+     * the two nodes directly below this one, so walking a view is no more expensive than walking
+     * the equivalent binary tree.
+     */
+    auto GetRangeView() const -> const OperandRange&
+    {
+        std::call_once(range->viewFlag, [this] {
+            const std::size_t split = range->shape == TreeShape::LeftLeaning
+                ? range->end - 1
+                : range->begin + std::bit_floor(range->end - range->begin - 1);
+            range->mostSigOp = MakeRangeNode(*range, range->begin, split);
+            range->leastSigOp = MakeRangeNode(*range, split, range->end);
+        });
+
+        return *range;
+    }
+
+    auto MostSigOpPtr() const -> const std::shared_ptr<const MostSigOpT>&
+    {
+        if constexpr (std::same_as<DerivedSpecialized, DerivedGeneralized>) {
+            if (range) {
+                return GetRangeView().mostSigOp;
+            }
+        }
+
+        return mostSigOp;
+    }
+
+    auto LeastSigOpPtr() const -> const std::shared_ptr<const LeastSigOpT>&
+    {
+        if constexpr (std::same_as<DerivedSpecialized, DerivedGeneralized>) {
+            if (range) {
+                return GetRangeView().leastSigOp;
+            }
+        }
+
+        return leastSigOp;
+    }
+
+    /**
+     * Turns this n-ary expression into a binary one whose operands are its current view, so that
+     * one of them may be replaced.
+     */
+    auto DetachOperands() -> void
+    {
+        if (!range) {
+            return;
+        }
+
+        auto most = MostSigOpPtr();
+        auto least = LeastSigOpPtr();
+        range.reset();
+        mostSigOp = std::move(most);
+        leastSigOp = std::move(least);
+    }
+
+    /**
+     * Invokes a function on the generalized form of this expression.
+     *
+     * The generalized view of a specialized expression shares its operands, so this does not copy
+     * the subtree.
+     */
+    template <typename FnT>
+    auto WithGeneralized(FnT&& fn) const -> decltype(auto)
+    {
+        if constexpr (std::same_as<DerivedSpecialized, DerivedGeneralized>) {
+            return fn(static_cast<const DerivedGeneralized&>(*this));
+        } else {
+            DerivedGeneralized generalized;
+            generalized.SetMostSigOp(std::shared_ptr<const Expression> { this->mostSigOp });
+            generalized.SetLeastSigOp(std::shared_ptr<const Expression> { this->leastSigOp });
+            return fn(std::as_const(generalized));
+        }
+    }
+
+    /**
+     * Recomputes the cached hash of this expression from the hashes of its operands.
+     *
+     * Operands of an associative expression contribute to a commutative sum, and operands of the same
+     * type contribute their own sums, so the hash is invariant under reordering and regrouping.
+     */
+    auto UpdateHash() -> void
+    {
+        const std::size_t seed = HashType(DerivedGeneralized::GetStaticType());
+
+        if constexpr ((DerivedGeneralized::GetStaticCategory() & Associative) != 0) {
+            std::size_t sum = 0;
+            for (const Expression* op : { static_cast<const Expression*>(mostSigOp.get()), static_cast<const Expression*>(leastSigOp.get()) }) {
+                if (op) {
+                    sum += HashContribution(*op);
+                }
+            }
+            hash = seed + sum;
+        } else {
+            hash = HashCombine(HashCombine(seed, mostSigOp ? mostSigOp->Hash() : 0), leastSigOp ? leastSigOp->Hash() : 0);
+        }
     }
 
-    std::unique_ptr<MostSigOpT> mostSigOp;
-    std::unique_ptr<LeastSigOpT> leastSigOp;
+    std::shared_ptr<const OperandRange> range;
+    std::size_t hash = 0;
 };
 
 } // Oasis
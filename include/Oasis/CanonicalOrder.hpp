@@ -0,0 +1,69 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_CANONICALORDER_HPP
+#define OASIS_CANONICALORDER_HPP
+
+#include <compare>
+#include <concepts>
+#include <memory>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/**
+ * Compares two expressions under a canonical total order.
+ *
+ * Expressions are ordered by type, then by their payload for leaves, such as the value of a `Real`
+ * or the name of a `Variable`, then by their operands. The operands of associative and commutative
+ * expressions are flattened and sorted before they are compared, so two expressions compare
+ * equivalent whenever they are `Equals`.
+ *
+ * @param lhs The left hand side of the comparison.
+ * @param rhs The right hand side of the comparison.
+ * @return The order of lhs relative to rhs.
+ */
+auto CanonicalCompare(const Expression& lhs, const Expression& rhs) -> std::weak_ordering;
+
+/**
+ * A less-than function object over expressions that follows CanonicalCompare.
+ *
+ * Expressions may be passed by reference or through any pointer-like type, so ranges of operands
+ * such as the result of `FlattenView` may be sorted directly.
+ */
+struct CanonicalLess {
+    template <typename LhsT, typename RhsT>
+    auto operator()(const LhsT& lhs, const RhsT& rhs) const -> bool
+    {
+        return CanonicalCompare(Deref(lhs), Deref(rhs)) < 0;
+    }
+
+private:
+    template <typename T>
+    static auto Deref(const T& expression) -> const Expression&
+    {
+        if constexpr (std::convertible_to<const T&, const Expression&>) {
+            return expression;
+        } else {
+            return *expression;
+        }
+    }
+};
+
+/**
+ * Rewrites an expression into its canonical form.
+ *
+ * The operands of every sum and product are flattened, canonicalized, sorted under CanonicalCompare,
+ * and stored in a single n-ary node. Every other expression keeps the order of its operands. Two
+ * expressions that are `Equals` have structurally equivalent canonical forms.
+ *
+ * @param expression The expression to canonicalize.
+ * @return The canonical form of the expression.
+ */
+auto Canonicalize(const Expression& expression) -> std::unique_ptr<Expression>;
+
+} // Oasis
+
+#endif // OASIS_CANONICALORDER_HPP
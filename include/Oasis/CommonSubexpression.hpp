@@ -0,0 +1,39 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_COMMONSUBEXPRESSION_HPP
+#define OASIS_COMMONSUBEXPRESSION_HPP
+
+#include <memory>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/**
+ * Turns an expression tree into a directed acyclic graph in which equal subexpressions are shared.
+ *
+ * The expression is interned into a fresh ExpressionPool, so operand order matters and only
+ * subexpressions with the same tree are merged. Every distinct subexpression of the result exists
+ * exactly once in memory, and every occurrence of it points to that one copy. The work is linear in
+ * the number of distinct subexpressions of the input, even when the input already shares
+ * subexpressions, so it stays cheap on results of differentiation that repeat the same operands
+ * many times over.
+ * @see ExpressionPool
+ *
+ * @param expression The expression to share the subexpressions of.
+ * @return An expression equal to `expression` whose equal subexpressions are shared.
+ */
+auto EliminateCommonSubexpressions(const Expression& expression) -> std::unique_ptr<Expression>;
+
+/**
+ * Counts the distinct nodes of an expression, counting a shared subexpression once.
+ * @param expression The expression to count the nodes of.
+ * @return The number of distinct nodes reachable from `expression`, including itself.
+ */
+auto CountDistinctNodes(const Expression& expression) -> std::size_t;
+
+} // Oasis
+
+#endif // OASIS_COMMONSUBEXPRESSION_HPP
@@ -0,0 +1,228 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_COMPILE_HPP
+#define OASIS_COMPILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class Variable;
+
+/**
+ * A closed interval of real numbers, which may be unbounded on either side.
+ */
+struct Interval {
+    double lower = 0.0;
+    double upper = 0.0;
+
+    /**
+     * Checks whether a number lies in the interval.
+     * @param value The number to check.
+     * @return Whether lower <= value <= upper.
+     */
+    [[nodiscard]] constexpr auto Contains(double value) const -> bool
+    {
+        return lower <= value && value <= upper;
+    }
+};
+
+/**
+ * An expression lowered to stack bytecode over doubles.
+ *
+ * A compiled expression evaluates the expression it was compiled from for given values of its
+ * variables, without building or simplifying any expression. Evaluation does not allocate, and a
+ * compiled expression may be evaluated from several threads at once.
+ *
+ * @see Compile
+ */
+class CompiledExpression {
+public:
+    /**
+     * Evaluates the expression.
+     *
+     * @param arguments The values of the variables, in the order they were given to Compile.
+     * @return The value of the expression.
+     * @throws std::invalid_argument if fewer arguments than variables are given.
+     */
+    auto operator()(std::span<const double> arguments) const -> double;
+
+    /**
+     * Evaluates the expression using a caller provided stack.
+     *
+     * @param arguments The values of the variables, in the order they were given to Compile.
+     * @param stack Scratch space of at least GetStackSize() values.
+     * @return The value of the expression.
+     */
+    auto Evaluate(std::span<const double> arguments, std::span<double> stack) const -> double;
+
+    /**
+     * Evaluates the expression for many sets of arguments at once.
+     *
+     * The arguments are given by column: `columns[i][j]` is the value of the i-th variable in the
+     * j-th set, and the value of the expression for the j-th set is written to `out[j]`. Arithmetic
+     * runs across sets on the widest vector instructions the processor supports, chosen at run
+     * time among AVX-512, AVX2, and SSE2 on x86, with a scalar loop elsewhere.
+     *
+     * @param columns The values of the variables, one column per variable in the order they were
+     * given to Compile.
+     * @param out The values of the expression.
+     * @throws std::invalid_argument if fewer columns than variables are given, or if a column is
+     * shorter than out.
+     */
+    auto EvaluateBatch(std::span<const std::span<const double>> columns, std::span<double> out) const -> void;
+
+    /**
+     * Evaluates the expression and its partial derivatives with respect to every variable in one
+     * pass, using forward mode automatic differentiation.
+     *
+     * Each value on the stack carries its derivatives alongside it, and every instruction applies
+     * the chain rule to them, following the rules `Differentiate` applies symbolically. No
+     * derivative expression is built or simplified.
+     *
+     * @param arguments The values of the variables, in the order they were given to Compile.
+     * @param gradient The partial derivatives of the expression, in the same order as the variables.
+     * @return The value of the expression.
+     * @throws std::invalid_argument if fewer arguments than variables are given, or if gradient has
+     * room for fewer derivatives than there are variables.
+     */
+    auto EvaluateGradient(std::span<const double> arguments, std::span<double> gradient) const -> double;
+
+    /**
+     * Evaluates the expression and its partial derivatives with respect to every variable, using
+     * reverse mode automatic differentiation.
+     *
+     * A forward pass records the value of every instruction on a tape, and a single backward pass
+     * accumulates the adjoint of each value into its operands. Unlike EvaluateGradient, whose cost
+     * grows with the number of variables, this costs a small constant multiple of one evaluation,
+     * which makes it the better choice for expressions over many variables.
+     *
+     * @param arguments The values of the variables, in the order they were given to Compile.
+     * @param gradient The partial derivatives of the expression, in the same order as the variables.
+     * @return The value of the expression.
+     * @throws std::invalid_argument if fewer arguments than variables are given, or if gradient has
+     * room for fewer derivatives than there are variables.
+     */
+    auto EvaluateAdjoint(std::span<const double> arguments, std::span<double> gradient) const -> double;
+
+    /**
+     * Bounds the values of the expression over a box of variable ranges, using interval arithmetic.
+     *
+     * Every instruction maps the intervals of its operands to an interval containing every value
+     * it can take on them, with bounds rounded outward, so the result contains the value of the
+     * expression at every point of the box where it is real. Sines and powers are bounded
+     * exactly on each monotonic segment. Where an instruction is undefined on part of its operands
+     * but not all of them, such as a logarithm of an interval reaching zero, the bound covers the
+     * part where it is defined; where it may be unbounded or is undefined everywhere, such as a
+     * quotient by an interval containing zero, the result is the whole real line.
+     *
+     * @param arguments The ranges of the variables, in the order they were given to Compile.
+     * @return An interval containing every value of the expression over the box.
+     * @throws std::invalid_argument if fewer arguments than variables are given.
+     */
+    auto EvaluateInterval(std::span<const Interval> arguments) const -> Interval;
+
+    /**
+     * Bounds the values of the expression over many boxes at once.
+     * @see EvaluateInterval
+     *
+     * The boxes are given by column: `columns[i][j]` is the range of the i-th variable in the j-th
+     * box, and the bound of the expression over the j-th box is written to `out[j]`.
+     *
+     * @param columns The ranges of the variables, one column per variable in the order they were
+     * given to Compile.
+     * @param out The bounds of the expression.
+     * @throws std::invalid_argument if fewer columns than variables are given, or if a column is
+     * shorter than out.
+     */
+    auto EvaluateIntervalBatch(std::span<const std::span<const Interval>> columns, std::span<Interval> out) const -> void;
+
+    /**
+     * Gets the number of variables the expression was compiled against.
+     * @return The number of variables.
+     */
+    [[nodiscard]] auto GetVariableCount() const -> std::size_t;
+
+    /**
+     * Gets the number of values the evaluation stack must be able to hold.
+     * @return The maximum depth of the evaluation stack.
+     */
+    [[nodiscard]] auto GetStackSize() const -> std::size_t;
+
+    /**
+     * Gets the number of instructions in the bytecode. Constant subexpressions are folded when the
+     * expression is compiled, so a constant expression compiles to a single instruction.
+     * @return The number of instructions.
+     */
+    [[nodiscard]] auto GetInstructionCount() const -> std::size_t;
+
+private:
+    friend class Compiler;
+
+    enum class OpCode : std::uint8_t {
+        Constant,
+        Load,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Exponent,
+        Log,
+        Negate,
+        Sine,
+        Magnitude,
+    };
+
+    struct Instruction {
+        OpCode code;
+        // The index of the constant for Constant, or of the argument for Load.
+        std::uint32_t index;
+    };
+
+    std::vector<Instruction> code;
+    std::vector<double> constants;
+    // Bounds on the exact value of each constant, for EvaluateInterval.
+    std::vector<Interval> constantBounds;
+    std::size_t variableCount = 0;
+    std::size_t stackSize = 0;
+};
+
+/**
+ * Compiles an expression to bytecode for fast repeated numeric evaluation.
+ *
+ * Sums, differences, products, quotients, powers, logarithms, sines, negations, magnitudes, real
+ * numbers, pi, and Euler's number are supported. Every variable in the expression must be one of
+ * `variables`.
+ *
+ * @param expression The expression to compile.
+ * @param variables The variables of the expression. Arguments are passed to the compiled expression
+ * in this order.
+ * @return The compiled expression, or an error if the expression contains an unsupported
+ * subexpression or an unknown variable.
+ */
+auto Compile(const Expression& expression, std::span<const Variable> variables) -> std::expected<CompiledExpression, std::string>;
+
+/**
+ * Computes the gradient of an expression at a point with one reverse mode sweep.
+ * @see CompiledExpression::EvaluateAdjoint
+ *
+ * @param expression The expression to differentiate.
+ * @param variables The variables to differentiate with respect to.
+ * @param values The values of the variables, in the same order.
+ * @return The partial derivatives of the expression, in the same order as the variables, or an
+ * error if the expression cannot be compiled or fewer values than variables are given.
+ */
+auto Gradient(const Expression& expression, std::span<const Variable> variables, std::span<const double> values) -> std::expected<std::vector<double>, std::string>;
+
+} // Oasis
+
+#endif // OASIS_COMPILE_HPP
@@ -0,0 +1,75 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_DIFFERENTIATEVISITOR_HPP
+#define OASIS_DIFFERENTIATEVISITOR_HPP
+
+#include <memory>
+#include <string>
+
+#include <gsl-lite/gsl-lite.hpp>
+
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Variable.hpp"
+#include "Oasis/Visit.hpp"
+
+namespace Oasis {
+
+/**
+ * Differentiates expressions with respect to a variable.
+ *
+ * The expression is walked once, bottom up, applying the sum, product, quotient, power, logarithm,
+ * and chain rules without simplifying along the way. Equal subexpressions are shared before the
+ * walk and differentiated once, and the derivative shares the operands of the original expression
+ * rather than copying them, so its size stays proportional to the size of the expression. The
+ * derivative is simplified once, at the end.
+ */
+class DifferentiateVisitor final : public TypedVisitor<std::expected<gsl_lite::not_null<std::unique_ptr<Expression>>, std::string>> {
+public:
+    /**
+     * Creates a visitor that differentiates with respect to `variable`.
+     * @param variable The variable to differentiate with respect to.
+     */
+    explicit DifferentiateVisitor(Variable variable);
+
+    /**
+     * Creates a visitor that differentiates with respect to `variable` and simplifies derivatives
+     * with `simplifyVisitor`, which must outlive this visitor.
+     * @param variable The variable to differentiate with respect to.
+     * @param simplifyVisitor The visitor used to simplify derivatives.
+     */
+    DifferentiateVisitor(Variable variable, SimplifyVisitor& simplifyVisitor);
+
+    auto TypedVisit(const Real& real) -> RetT override;
+    auto TypedVisit(const Imaginary& imaginary) -> RetT override;
+    auto TypedVisit(const Variable& variable) -> RetT override;
+    auto TypedVisit(const Undefined& undefined) -> RetT override;
+    auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override;
+    auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override;
+    auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override;
+    auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override;
+    auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override;
+    auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override;
+    auto TypedVisit(const Negate<Expression>& negate) -> RetT override;
+    auto TypedVisit(const Sine<Expression>& sine) -> RetT override;
+    auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT override;
+    auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT override;
+    auto TypedVisit(const Matrix& matrix) -> RetT override;
+    auto TypedVisit(const EulerNumber&) -> RetT override;
+    auto TypedVisit(const Pi&) -> RetT override;
+    auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override;
+
+private:
+    auto Differentiate(const Expression& expression) -> RetT;
+
+    Variable variable;
+
+    // Set when no visitor was given, so that copies of this visitor share it.
+    std::shared_ptr<SimplifyVisitor> ownSimplifyVisitor;
+    SimplifyVisitor* simplifyVisitor;
+};
+
+} // Oasis
+
+#endif // OASIS_DIFFERENTIATEVISITOR_HPP
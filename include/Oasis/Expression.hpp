@@ -15,6 +15,10 @@ namespace Oasis {
 using any = boost::anys::unique_any;
 
 class Visitor;
+class TypedVisitorBase;
+
+template <typename T>
+class TypedVisitor;
 
 /**
  * The type of an expression.
@@ -64,6 +68,10 @@ class Expression {
 public:
     /**
      * Copies this expression.
+     *
+     * Since expressions are immutable, the copy shares its operands with this expression and only
+     * the root node is allocated, so copying takes constant time however large the expression is.
+     *
      * @return A copy of this expression.
      */
     [[nodiscard]] virtual auto Copy() const -> std::unique_ptr<Expression> = 0;
@@ -100,6 +108,16 @@ public:
      */
     [[nodiscard]] virtual auto GetCategory() const -> uint32_t;
 
+    /**
+     * Gets an operand of this expression without copying it.
+     *
+     * @param index The index of the operand. The most significant operand of a binary expression,
+     * and the operand of a unary expression, have index 0. The least significant operand of a binary
+     * expression has index 1.
+     * @return The operand, or nullptr if this expression has no operand at that index.
+     */
+    [[nodiscard]] virtual auto GetOperandAt(std::size_t index) const -> const Expression*;
+
     /**
      * Gets the type of this expression.
      * @return The type of this expression.
@@ -118,6 +136,18 @@ public:
      */
     [[nodiscard]] virtual auto Generalize() const -> std::unique_ptr<Expression>;
 
+    /**
+     * Gets the structural hash of this expression.
+     *
+     * Expressions that are equal according to `Equals` have the same hash. The hash of an
+     * associative expression, such as an `Add`, does not depend on the order or grouping of its
+     * operands. Composite expressions compute their hash once when their operands are set, so this
+     * is a constant-time operation.
+     *
+     * @return The structural hash of this expression.
+     */
+    [[nodiscard]] virtual auto Hash() const -> std::size_t = 0;
+
     /**
      * Attempts to integrate this expression using integration rules
      *
@@ -176,6 +206,16 @@ public:
      */
     [[nodiscard]] virtual auto StructurallyEquivalent(const Expression& other) const -> bool = 0;
 
+    /**
+     * Substitutes a value for a variable, then simplifies the result.
+     * @see Oasis::Substitute
+     *
+     * @param var The variable to substitute for.
+     * @param val The value to substitute.
+     * @return This expression with the value substituted, simplified unless simplification fails.
+     * @throws std::invalid_argument if var is not a Variable and this expression is a variable or
+     * has operands, whether or not it contains any variable.
+     */
     [[nodiscard]] virtual auto Substitute(const Expression& var, const Expression& val) -> std::unique_ptr<Expression> = 0;
 
     template <IVisitor T>
@@ -194,15 +234,28 @@ protected:
      * @param visitor The serializer class object to write the Expression data.
      */
     virtual any AcceptInternal(Visitor& visitor) const = 0;
+
+    /**
+     * Dispatches a typed visitor on this expression. The visitor keeps the result of the visit
+     * rather than returning it, so it is not type-erased.
+     *
+     * @param visitor The visitor to dispatch.
+     */
+    virtual auto AcceptInternal(TypedVisitorBase& visitor) const -> void = 0;
 };
 
 template <IVisitor T>
 auto Expression::Accept(T& visitor) const -> std::expected<typename T::RetT, std::string_view>
 {
-    try {
-        return boost::any_cast<typename T::RetT>(this->AcceptInternal(visitor));
-    } catch (boost::bad_any_cast& e) {
-        return std::unexpected { e.what() };
+    if constexpr (std::derived_from<T, TypedVisitor<typename T::RetT>>) {
+        this->AcceptInternal(static_cast<TypedVisitorBase&>(visitor));
+        return static_cast<TypedVisitor<typename T::RetT>&>(visitor).TakeResult();
+    } else {
+        try {
+            return boost::any_cast<typename T::RetT>(this->AcceptInternal(static_cast<Visitor&>(visitor)));
+        } catch (boost::bad_any_cast& e) {
+            return std::unexpected { e.what() };
+        }
     }
 }
 
@@ -210,22 +263,27 @@ template <IVisitor T>
     requires ExpectedWithString<typename T::RetT>
 auto Expression::Accept(T& visitor) const -> typename T::RetT
 {
-    try {
-        return boost::any_cast<typename T::RetT>(this->AcceptInternal(static_cast<Visitor&>(visitor)));
-    } catch (boost::bad_any_cast& e) {
-        return std::unexpected { e.what() };
+    if constexpr (std::derived_from<T, TypedVisitor<typename T::RetT>>) {
+        this->AcceptInternal(static_cast<TypedVisitorBase&>(visitor));
+        return static_cast<TypedVisitor<typename T::RetT>&>(visitor).TakeResult();
+    } else {
+        try {
+            return boost::any_cast<typename T::RetT>(this->AcceptInternal(static_cast<Visitor&>(visitor)));
+        } catch (boost::bad_any_cast& e) {
+            return std::unexpected { e.what() };
+        }
     }
 }
 
-#define EXPRESSION_TYPE(type)                       \
-    auto GetType() const -> ExpressionType override \
-    {                                               \
-        return ExpressionType::type;                \
-    }                                               \
-                                                    \
-    static auto GetStaticType() -> ExpressionType   \
-    {                                               \
-        return ExpressionType::type;                \
+#define EXPRESSION_TYPE(type)                               \
+    auto GetType() const -> ExpressionType override         \
+    {                                                       \
+        return ExpressionType::type;                        \
+    }                                                       \
+                                                            \
+    constexpr static auto GetStaticType() -> ExpressionType \
+    {                                                       \
+        return ExpressionType::type;                        \
     }
 
 #define EXPRESSION_CATEGORY(category)                     \
@@ -0,0 +1,126 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_EXPRESSIONCACHE_HPP
+#define OASIS_EXPRESSIONCACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "Hash.hpp"
+
+namespace Oasis {
+
+/**
+ * A bounded cache of values keyed by expression, with least recently used eviction.
+ *
+ * Keys are hashed with `Expression::Hash` and compared with ExpressionIdentical, so a lookup hits
+ * for any expression with the same tree as a cached key, regardless of where that expression lives.
+ * Operand order matters: `Multiply { A, B }` and `Multiply { B, A }` are distinct keys, which keeps
+ * non-commutative operands such as matrices apart. The cache stores its own copy of each key. A
+ * cache is not thread safe.
+ *
+ * @tparam ValueT The type of the cached values.
+ */
+template <typename ValueT>
+class ExpressionCache {
+public:
+    /**
+     * Creates a cache that holds at most `capacity` entries.
+     * @param capacity The maximum number of entries. A capacity of zero caches nothing.
+     */
+    explicit ExpressionCache(std::size_t capacity)
+        : capacity(capacity)
+    {
+    }
+
+    /**
+     * Looks up the value cached for an expression and marks it as the most recently used.
+     * @param key The expression to look up.
+     * @return The cached value, or nullptr if the expression is not cached. The pointer is
+     * invalidated by the next insertion.
+     */
+    auto Find(const Expression& key) -> const ValueT*
+    {
+        auto it = index.find(&key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->value;
+    }
+
+    /**
+     * Caches a value for an expression, evicting the least recently used entry if the cache is full.
+     * If the expression is already cached, its value is replaced.
+     * @param key The expression to cache the value for.
+     * @param value The value to cache.
+     */
+    auto Insert(const Expression& key, ValueT value) -> void
+    {
+        if (capacity == 0) {
+            return;
+        }
+
+        if (auto it = index.find(&key); it != index.end()) {
+            it->second->value = std::move(value);
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+
+        if (entries.size() == capacity) {
+            index.erase(entries.back().key.get());
+            entries.pop_back();
+        }
+
+        entries.push_front(Entry { key.Copy(), std::move(value) });
+        index.emplace(entries.front().key.get(), entries.begin());
+    }
+
+    /**
+     * Gets the number of cached entries.
+     * @return The number of cached entries.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t
+    {
+        return entries.size();
+    }
+
+    /**
+     * Gets the maximum number of cached entries.
+     * @return The maximum number of cached entries.
+     */
+    [[nodiscard]] auto Capacity() const -> std::size_t
+    {
+        return capacity;
+    }
+
+    /**
+     * Removes every entry from the cache.
+     */
+    auto Clear() -> void
+    {
+        index.clear();
+        entries.clear();
+    }
+
+private:
+    struct Entry {
+        std::unique_ptr<Expression> key;
+        ValueT value;
+    };
+
+    std::size_t capacity;
+
+    // Entries are ordered from most to least recently used.
+    std::list<Entry> entries;
+    std::unordered_map<const Expression*, typename std::list<Entry>::iterator, ExpressionHash, ExpressionIdentical> index;
+};
+
+} // Oasis
+
+#endif // OASIS_EXPRESSIONCACHE_HPP
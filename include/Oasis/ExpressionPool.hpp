@@ -0,0 +1,114 @@
+//
+// Created by agent on 10/17/26.
+//
+
+#ifndef OASIS_EXPRESSIONPOOL_HPP
+#define OASIS_EXPRESSIONPOOL_HPP
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Oasis/Visit.hpp"
+
+namespace Oasis {
+
+/**
+ * A hash-consing pool of expressions.
+ *
+ * Interning an expression yields a canonical node that is shared by every structurally identical
+ * expression interned into the same pool. Two nodes are identical when they have the same type,
+ * the same interned operands, and the same leaf payload, such as the value of a `Real` or the name
+ * of a `Variable`. Because identical expressions share a single node, two interned expressions
+ * that are the same pointer are `Equals`. The converse does not hold for sums and products, whose
+ * operands are identified in order: `x + y` and `y + x`, or `(x + y) + z` and `x + (y + z)`, are
+ * `Equals` but intern to distinct nodes. Interning their canonical forms shares them as well.
+ * @see Canonicalize
+ *
+ * Interning visits every distinct node of the input once, so an input that already shares
+ * subexpressions is interned in time linear in its distinct nodes rather than in its tree size.
+ *
+ * Interning is opt-in: expressions built outside of a pool are unaffected. A pool keeps every node
+ * it has handed out alive until it is cleared or destroyed, and is not thread safe.
+ */
+class ExpressionPool final : public TypedVisitor<std::expected<std::shared_ptr<const Expression>, std::string>> {
+public:
+    /**
+     * Interns an expression and all of its subexpressions.
+     * @param expression The expression to intern.
+     * @return The canonical node for the expression.
+     */
+    auto Intern(const Expression& expression) -> std::shared_ptr<const Expression>;
+
+    /**
+     * Gets the number of distinct nodes in this pool.
+     * @return The number of distinct nodes in this pool.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t;
+
+    /**
+     * Releases every node held by this pool. Nodes that are still referenced elsewhere stay alive,
+     * but will no longer be shared with expressions interned afterward.
+     */
+    auto Clear() -> void;
+
+    auto TypedVisit(const Real& real) -> RetT override;
+    auto TypedVisit(const Imaginary& imaginary) -> RetT override;
+    auto TypedVisit(const Variable& variable) -> RetT override;
+    auto TypedVisit(const Undefined& undefined) -> RetT override;
+    auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override;
+    auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override;
+    auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override;
+    auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override;
+    auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override;
+    auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override;
+    auto TypedVisit(const Negate<Expression>& negate) -> RetT override;
+    auto TypedVisit(const Sine<Expression>& sine) -> RetT override;
+    auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT override;
+    auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT override;
+    auto TypedVisit(const Matrix& matrix) -> RetT override;
+    auto TypedVisit(const EulerNumber&) -> RetT override;
+    auto TypedVisit(const Pi&) -> RetT override;
+    auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override;
+
+private:
+    /**
+     * Identifies a node by its type, the identities of its interned operands, and its leaf payload.
+     */
+    struct Key {
+        ExpressionType type = ExpressionType::None;
+        std::array<const Expression*, 2> operands {};
+        std::vector<double> values {};
+        std::string name {};
+
+        auto operator==(const Key& other) const -> bool = default;
+    };
+
+    struct KeyHash {
+        auto operator()(const Key& key) const -> std::size_t;
+    };
+
+    auto InternOperand(const std::shared_ptr<const Expression>& operand) -> RetT;
+
+    template <template <typename, typename> typename T>
+    auto InternBinary(const T<Expression, Expression>& binary) -> RetT;
+
+    template <template <typename> typename T>
+    auto InternUnary(const T<Expression>& unary) -> RetT;
+
+    template <typename T>
+    auto InternLeaf(const T& leaf, Key key) -> RetT;
+
+    std::unordered_map<Key, std::shared_ptr<const Expression>, KeyHash> nodes;
+
+    // The interned node of every operand visited by the current call to Intern, keyed by the
+    // operand, which is held so that its address is not reused while the entry exists.
+    std::unordered_map<const Expression*, std::pair<std::shared_ptr<const Expression>, std::shared_ptr<const Expression>>> visited;
+};
+
+} // Oasis
+
+#endif // OASIS_EXPRESSIONPOOL_HPP
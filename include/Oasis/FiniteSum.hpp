@@ -0,0 +1,64 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_FINITESUM_HPP
+#define OASIS_FINITESUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+
+#include "Compile.hpp"
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class Variable;
+
+struct SummationOpts {
+    /**
+     * The maximum number of threads terms are summed on. Zero uses one thread per hardware thread.
+     * Short ranges are always summed on the calling thread.
+     */
+    std::size_t threads = 0;
+};
+
+/**
+ * Sums a compiled expression of one variable over a range of integers.
+ *
+ * The range is split into blocks whose size depends only on its length. The terms of each block
+ * are evaluated in batches and added with Neumaier's compensated summation, and the sums of the
+ * blocks are added the same way, in order. Blocks are spread across threads, and the result does
+ * not depend on the number of threads.
+ *
+ * @param summand The summand, compiled against at most one variable, the index of summation.
+ * @param lower The first index, inclusive.
+ * @param upper The last index, inclusive. The sum is zero if it is less than `lower`.
+ * @param opts The threads to sum on.
+ * @return The sum of the summand over the range.
+ * @throws std::invalid_argument if the summand has more than one variable.
+ */
+auto CompensatedSum(const CompiledExpression& summand, std::int64_t lower, std::int64_t upper, const SummationOpts& opts = {}) -> double;
+
+/**
+ * Evaluates a finite sum to a number.
+ *
+ * A summand that is a polynomial in the index with numeric coefficients is summed in closed form,
+ * with Faulhaber's formula, in time independent of the length of the range. Any other summand is
+ * summed term by term with CompensatedSum.
+ *
+ * @param summand The expression to sum.
+ * @param index The index of summation.
+ * @param lower The first index, inclusive, which must simplify to an integer.
+ * @param upper The last index, inclusive, which must simplify to an integer.
+ * @param opts The threads to sum on.
+ * @return The sum, or an error if a bound is not an integer or the summand depends on another
+ * variable.
+ */
+auto EvaluateSummation(const Expression& summand, const Variable& index, const Expression& lower, const Expression& upper, const SummationOpts& opts = {}) -> std::expected<double, std::string>;
+
+} // Oasis
+
+#endif // OASIS_FINITESUM_HPP
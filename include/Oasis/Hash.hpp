@@ -0,0 +1,159 @@
+//
+// Created by agent on 10/17/26.
+//
+
+#ifndef OASIS_HASH_HPP
+#define OASIS_HASH_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/**
+ * Scrambles the bits of a hash value using the SplitMix64 finalizer.
+ * @param value The value to scramble.
+ * @return The scrambled value.
+ */
+constexpr auto HashMix(std::uint64_t value) -> std::size_t
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return static_cast<std::size_t>(value);
+}
+
+/**
+ * Combines a hash value into a seed in an order-dependent way.
+ * @param seed The running hash.
+ * @param value The hash value to combine into the seed.
+ * @return The combined hash.
+ */
+constexpr auto HashCombine(std::size_t seed, std::size_t value) -> std::size_t
+{
+    return seed ^ (HashMix(value) + 0x9e3779b9U + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * Gets the hash seed of an expression type.
+ * @param type The type of the expression.
+ * @return The hash seed of the expression type.
+ */
+constexpr auto HashType(ExpressionType type) -> std::size_t
+{
+    return HashMix(static_cast<std::uint64_t>(type) + 1);
+}
+
+/**
+ * A hash function object over expressions, for use as the hasher of unordered containers.
+ *
+ * Expressions may be passed by reference or through any pointer-like type, such as a raw pointer,
+ * a `std::unique_ptr`, or a `std::shared_ptr`. The hasher is transparent, so containers keyed on
+ * owning pointers may be queried with a plain `const Expression&`.
+ */
+struct ExpressionHash {
+    using is_transparent = void;
+
+    auto operator()(const Expression& expression) const -> std::size_t
+    {
+        return expression.Hash();
+    }
+
+    template <typename PtrT>
+        requires requires(const PtrT& ptr) { { *ptr } -> std::convertible_to<const Expression&>; }
+    auto operator()(const PtrT& ptr) const -> std::size_t
+    {
+        return ptr->Hash();
+    }
+};
+
+/**
+ * An equality function object over expressions that compares them with `Expression::Equals`.
+ * @see ExpressionHash
+ */
+struct ExpressionEqual {
+    using is_transparent = void;
+
+    template <typename LhsT, typename RhsT>
+    auto operator()(const LhsT& lhs, const RhsT& rhs) const -> bool
+    {
+        return Deref(lhs).Equals(Deref(rhs));
+    }
+
+private:
+    template <typename T>
+    static auto Deref(const T& expression) -> const Expression&
+    {
+        if constexpr (std::convertible_to<const T&, const Expression&>) {
+            return expression;
+        } else {
+            return *expression;
+        }
+    }
+};
+
+/**
+ * An equality function object over expressions that only accepts identical trees.
+ *
+ * Unlike ExpressionEqual, operands are compared in order, so `Add { x, y }` and `Add { y, x }` are
+ * not identical. Leaves are compared with `Expression::Equals`. Identical expressions are equal,
+ * so ExpressionHash may be used alongside this comparison.
+ * @see ExpressionHash
+ */
+struct ExpressionIdentical {
+    using is_transparent = void;
+
+    template <typename LhsT, typename RhsT>
+    auto operator()(const LhsT& lhs, const RhsT& rhs) const -> bool
+    {
+        return Identical(Deref(lhs), Deref(rhs));
+    }
+
+private:
+    static auto Identical(const Expression& lhs, const Expression& rhs) -> bool
+    {
+        if (&lhs == &rhs) {
+            return true;
+        }
+
+        if (lhs.GetType() != rhs.GetType() || lhs.Hash() != rhs.Hash()) {
+            return false;
+        }
+
+        if (!lhs.GetOperandAt(0) && !rhs.GetOperandAt(0)) {
+            return lhs.Equals(rhs);
+        }
+
+        for (std::size_t i = 0;; ++i) {
+            const Expression* lhsOp = lhs.GetOperandAt(i);
+            const Expression* rhsOp = rhs.GetOperandAt(i);
+
+            if (!lhsOp || !rhsOp) {
+                return lhsOp == rhsOp;
+            }
+
+            if (!Identical(*lhsOp, *rhsOp)) {
+                return false;
+            }
+        }
+    }
+
+    template <typename T>
+    static auto Deref(const T& expression) -> const Expression&
+    {
+        if constexpr (std::convertible_to<const T&, const Expression&>) {
+            return expression;
+        } else {
+            return *expression;
+        }
+    }
+};
+
+} // Oasis
+
+#endif // OASIS_HASH_HPP
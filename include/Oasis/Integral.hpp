@@ -23,7 +23,7 @@ public:
     [[deprecated]] [[nodiscard]] auto Simplify(const Expression& upper, const Expression& lower) const -> std::unique_ptr<Expression> /* final */;
 
     EXPRESSION_TYPE(Integral)
-    EXPRESSION_CATEGORY(Associative | Commutative)
+    EXPRESSION_CATEGORY(BinExp)
 };
 /// @endcond
 
@@ -72,7 +72,7 @@ public:
     auto operator=(const Integral& other) -> Integral& = default;
 
     EXPRESSION_TYPE(Integral)
-    EXPRESSION_CATEGORY(Associative | Commutative)
+    EXPRESSION_CATEGORY(BinExp)
 };
 
 } // namespace Oasis
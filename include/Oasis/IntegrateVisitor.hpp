@@ -0,0 +1,118 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_INTEGRATEVISITOR_HPP
+#define OASIS_INTEGRATEVISITOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <gsl-lite/gsl-lite.hpp>
+
+#include "Oasis/ExpressionCache.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Variable.hpp"
+#include "Oasis/Visit.hpp"
+
+namespace Oasis {
+
+struct IntegrateOpts {
+    /**
+     * The maximum number of rules applied while integrating one expression. An integral that needs
+     * more is left unevaluated, which bounds the time spent on integrals with no closed form.
+     */
+    std::size_t ruleBudget = 256;
+
+    /**
+     * The maximum number of times integration by parts is nested.
+     */
+    std::size_t partsDepth = 4;
+
+    /**
+     * The maximum number of antiderivatives a visitor remembers.
+     */
+    std::size_t memoCapacity = 256;
+};
+
+/**
+ * Integrates expressions with respect to a variable.
+ *
+ * The integrand is simplified, then matched against the rules for the type of its outermost
+ * expression: the constant, power, exponential, and logarithm rules, linearity, and integration by
+ * parts. Antiderivatives of subexpressions are remembered, so an integrand met again, by this or a
+ * later integration with the same visitor, is not integrated twice. An integrand that no rule
+ * matches within the rule budget is left as an unevaluated Integral.
+ *
+ * Antiderivatives are returned with a constant of integration, `C`.
+ */
+class IntegrateVisitor final : public TypedVisitor<std::expected<gsl_lite::not_null<std::unique_ptr<Expression>>, std::string>> {
+public:
+    /**
+     * Creates a visitor that integrates with respect to `variable`.
+     * @param variable The variable to integrate with respect to.
+     * @param opts The limits on the work done for each integral.
+     */
+    explicit IntegrateVisitor(Variable variable, IntegrateOpts opts = {});
+
+    /**
+     * Creates a visitor that integrates with respect to `variable` and simplifies integrands and
+     * antiderivatives with `simplifyVisitor`, which must outlive this visitor.
+     * @param variable The variable to integrate with respect to.
+     * @param simplifyVisitor The visitor used to simplify integrands and antiderivatives.
+     * @param opts The limits on the work done for each integral.
+     */
+    IntegrateVisitor(Variable variable, SimplifyVisitor& simplifyVisitor, IntegrateOpts opts = {});
+
+    auto TypedVisit(const Real& real) -> RetT override;
+    auto TypedVisit(const Imaginary& imaginary) -> RetT override;
+    auto TypedVisit(const Variable& variable) -> RetT override;
+    auto TypedVisit(const Undefined& undefined) -> RetT override;
+    auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override;
+    auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override;
+    auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override;
+    auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override;
+    auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override;
+    auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override;
+    auto TypedVisit(const Negate<Expression>& negate) -> RetT override;
+    auto TypedVisit(const Sine<Expression>& sine) -> RetT override;
+    auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT override;
+    auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT override;
+    auto TypedVisit(const Matrix& matrix) -> RetT override;
+    auto TypedVisit(const EulerNumber&) -> RetT override;
+    auto TypedVisit(const Pi&) -> RetT override;
+    auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override;
+
+    /**
+     * Gets the number of antiderivatives this visitor has remembered.
+     * @return The number of remembered antiderivatives.
+     */
+    [[nodiscard]] auto GetMemoSize() const -> std::size_t;
+
+    /**
+     * Integrates an expression without adding a constant of integration.
+     * @param integrand The expression to integrate.
+     * @return The antiderivative of the integrand, or nullptr if no rule matches it within the rule
+     * budget or it cannot be simplified.
+     */
+    auto Antiderivative(const Expression& integrand) -> std::unique_ptr<Expression>;
+
+private:
+    auto Integrate(const Expression& integrand) -> RetT;
+
+    Variable variable;
+    IntegrateOpts options;
+
+    // Set when no visitor was given, so that copies of this visitor share it.
+    std::shared_ptr<SimplifyVisitor> ownSimplifyVisitor;
+    SimplifyVisitor* simplifyVisitor;
+
+    // Antiderivatives without their constant of integration, keyed by simplified integrand. Shared
+    // so that copies of a visitor share what it has learned.
+    std::shared_ptr<ExpressionCache<std::shared_ptr<const Expression>>> memo;
+};
+
+} // Oasis
+
+#endif // OASIS_INTEGRATEVISITOR_HPP
@@ -6,6 +6,7 @@
 #define OASIS_LEAFEXPRESSION_HPP
 
 #include "Expression.hpp"
+#include "Hash.hpp"
 #include "Visit.hpp"
 
 namespace Oasis {
@@ -25,6 +26,11 @@ public:
         return std::make_unique<DerivedT>(*static_cast<const DerivedT*>(this));
     }
 
+    [[nodiscard]] auto Hash() const -> std::size_t override
+    {
+        return HashType(DerivedT::GetStaticType());
+    }
+
     [[nodiscard]] auto StructurallyEquivalent(const Expression& other) const -> bool final
     {
         return this->GetType() == other.GetType();
@@ -46,9 +52,12 @@ public:
 
     auto AcceptInternal(Visitor& visitor) const -> any override
     {
-        const auto generalized = Generalize();
-        const auto& derivedGeneralized = dynamic_cast<const DerivedT&>(*generalized);
-        return visitor.Visit(derivedGeneralized);
+        return visitor.Visit(*static_cast<const DerivedT*>(this));
+    }
+
+    auto AcceptInternal(TypedVisitorBase& visitor) const -> void override
+    {
+        visitor.Dispatch(*static_cast<const DerivedT*>(this));
     }
 };
 
@@ -20,14 +20,19 @@
 #include <boost/callable_traits/args.hpp>
 #include <boost/mpl/for_each.hpp>
 #include <boost/mpl/push_back.hpp>
+#include <boost/mpl/size.hpp>
 #include <boost/mpl/vector.hpp>
 
 #include <gsl-lite/gsl-lite.hpp>
 
+#include <algorithm>
+#include <array>
 #include <concepts>
 #include <functional>
 #include <tuple>
 
+#include "Expression.hpp"
+
 namespace Oasis {
 template <typename Lambda>
 using lambda_argument_type = std::remove_cvref_t<std::tuple_element_t<0, boost::callable_traits::args_t<Lambda>>>;
@@ -37,6 +42,76 @@ concept TransformerAcceptsCheckArg = requires(TransformerF f, const lambda_argum
     { f(t, nullptr) } -> std::same_as<std::expected<gsl_lite::not_null<std::unique_ptr<ArgumentT>>, std::string_view>>;
 } && std::predicate<CheckF, const lambda_argument_type<CheckF>&>;
 
+/**
+ * The type at the head of a pattern, or ExpressionType::None if the pattern matches any expression.
+ */
+template <typename PatternT>
+constexpr auto PatternHead() -> ExpressionType
+{
+    if constexpr (std::is_same_v<PatternT, Expression>) {
+        return ExpressionType::None;
+    } else {
+        return PatternT::GetStaticType();
+    }
+}
+
+/**
+ * The heads of a pattern and of its operands, which an expression must have for the pattern to match.
+ */
+struct PatternSignature {
+    ExpressionType head = ExpressionType::None;
+    std::array<ExpressionType, 2> operands { ExpressionType::None, ExpressionType::None };
+
+    /**
+     * Checks whether an expression with the given heads could match the pattern.
+     *
+     * @param type The type of the expression.
+     * @param operandTypes The types of the expression's operands.
+     * @param commutative Whether the operands of the expression may be swapped.
+     * @return false if the pattern cannot match, true if it might.
+     */
+    [[nodiscard]] constexpr auto Admits(ExpressionType type, const std::array<ExpressionType, 2>& operandTypes, bool commutative) const -> bool
+    {
+        if (head == ExpressionType::None) {
+            return true;
+        }
+
+        if (head != type) {
+            return false;
+        }
+
+        constexpr auto admitsOperand = [](ExpressionType pattern, ExpressionType operand) {
+            return pattern == ExpressionType::None || pattern == operand;
+        };
+
+        return (admitsOperand(operands[0], operandTypes[0]) && admitsOperand(operands[1], operandTypes[1]))
+            || (commutative && admitsOperand(operands[0], operandTypes[1]) && admitsOperand(operands[1], operandTypes[0]));
+    }
+};
+
+template <typename PatternT>
+struct PatternSignatureOf {
+    static constexpr PatternSignature value { PatternHead<PatternT>() };
+};
+
+template <template <typename, typename> typename DerivedT, typename MostSigOpT, typename LeastSigOpT>
+    requires DerivedFromBinaryExpression<DerivedT<MostSigOpT, LeastSigOpT>>
+struct PatternSignatureOf<DerivedT<MostSigOpT, LeastSigOpT>> {
+    static constexpr PatternSignature value { PatternHead<DerivedT<MostSigOpT, LeastSigOpT>>(), { PatternHead<MostSigOpT>(), PatternHead<LeastSigOpT>() } };
+};
+
+template <template <typename> typename DerivedT, typename OperandT>
+    requires(DerivedFromUnaryExpression<DerivedT<OperandT>> && !DerivedFromBinaryExpression<DerivedT<OperandT>>)
+struct PatternSignatureOf<DerivedT<OperandT>> {
+    static constexpr PatternSignature value { PatternHead<DerivedT<OperandT>>(), { PatternHead<OperandT>(), ExpressionType::None } };
+};
+
+/**
+ * A unique address per type, used to identify cached casts without RTTI.
+ */
+template <typename T>
+inline constexpr char MatchCastTag {};
+
 template <typename ArgumentT, typename Cases>
 class MatchCastImpl {
 public:
@@ -53,6 +128,21 @@ public:
         requires IVisitor<std::remove_pointer_t<VisitorPtrT>> || std::same_as<VisitorPtrT, std::nullptr_t>
     auto Execute(const ArgumentT& arg, VisitorPtrT visitor) const -> std::expected<std::unique_ptr<ArgumentT>, std::string_view>
     {
+        // The heads of the argument and its operands are read once, and only cases whose pattern
+        // signature admits them are cast. Cases sharing a pattern share a single cast.
+        const ExpressionType argType = arg.GetType();
+        const std::array<ExpressionType, 2> operandTypes {
+            arg.GetOperandAt(0) ? arg.GetOperandAt(0)->GetType() : ExpressionType::None,
+            arg.GetOperandAt(1) ? arg.GetOperandAt(1)->GetType() : ExpressionType::None
+        };
+        const bool commutative = arg.GetCategory() & Commutative;
+
+        struct CachedCast {
+            const void* tag = nullptr;
+            std::unique_ptr<Expression> result;
+        };
+        std::array<CachedCast, boost::mpl::size<Cases>::value> casts {};
+
         std::expected<std::unique_ptr<ArgumentT>, std::string_view> result = nullptr;
         boost::mpl::for_each<Cases>(
             [&]<typename Check, typename Transformer>(std::pair<Check, Transformer> checkAndTransformer) {
@@ -60,8 +150,19 @@ public:
                 if (!result.has_value() || (result.has_value() && *result))
                     return;
 
+                if (!PatternSignatureOf<CaseType>::value.Admits(argType, operandTypes, commutative))
+                    return;
+
+                auto cached = std::find_if(casts.begin(), casts.end(), [](const CachedCast& cast) {
+                    return cast.tag == &MatchCastTag<CaseType> || cast.tag == nullptr;
+                });
+                if (cached->tag == nullptr) {
+                    cached->tag = &MatchCastTag<CaseType>;
+                    cached->result = RecursiveCast<CaseType>(arg);
+                }
+
                 auto [check, transformer] = checkAndTransformer;
-                if (std::unique_ptr<CaseType> castResult = RecursiveCast<CaseType>(arg); castResult && check(*castResult))
+                if (const auto* castResult = static_cast<const CaseType*>(cached->result.get()); castResult && check(*castResult))
                     result = transformer(*castResult, visitor).transform([](gsl_lite::not_null<std::unique_ptr<ArgumentT>>&& transformResult) { return std::move(transformResult); });
             });
         return result;
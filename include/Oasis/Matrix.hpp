@@ -24,6 +24,8 @@ public:
 
     [[nodiscard]] auto Equals(const Expression& other) const -> bool final;
 
+    [[nodiscard]] auto Hash() const -> std::size_t final;
+
     EXPRESSION_TYPE(Matrix)
     EXPRESSION_CATEGORY(UnExp)
 
@@ -0,0 +1,105 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_QUADRATURE_HPP
+#define OASIS_QUADRATURE_HPP
+
+#include <cstddef>
+#include <expected>
+#include <string>
+
+#include "Compile.hpp"
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class Variable;
+
+struct QuadratureOpts {
+    /**
+     * The largest acceptable estimate of the absolute error.
+     */
+    double absoluteTolerance = 1e-10;
+
+    /**
+     * The largest acceptable estimate of the error relative to the magnitude of the integral. The
+     * integral converges once either tolerance is met.
+     */
+    double relativeTolerance = 1e-10;
+
+    /**
+     * The maximum number of subintervals the interval of integration is split into.
+     */
+    std::size_t maxIntervals = 2048;
+
+    /**
+     * The maximum number of threads the integrand is evaluated on. Zero uses one thread per
+     * hardware thread. Small batches of subintervals are always evaluated on the calling thread.
+     */
+    std::size_t threads = 0;
+};
+
+struct QuadratureResult {
+    /**
+     * The value of the integral.
+     */
+    double value = 0.0;
+
+    /**
+     * An estimate of the absolute error of the value.
+     */
+    double error = 0.0;
+
+    /**
+     * The number of subintervals the value was computed over, or zero if it was computed exactly.
+     */
+    std::size_t intervals = 0;
+
+    /**
+     * Whether the error estimate is within tolerance. When false, the value is the best estimate
+     * found before the interval limit was reached or the integrand stopped being finite.
+     */
+    bool converged = true;
+};
+
+/**
+ * Numerically integrates a compiled expression of one variable between two bounds.
+ *
+ * Each subinterval is integrated with the 15 point Gauss–Kronrod rule, and the difference from
+ * the embedded 7 point Gauss rule estimates its error. While the total error is out of tolerance,
+ * every subinterval whose error exceeds its share of the tolerance is bisected, and the integrand
+ * is evaluated at the nodes of all new subintervals at once, in batches spread across threads. The
+ * result does not depend on the number of threads.
+ *
+ * @param integrand The integrand, compiled against at most one variable.
+ * @param lower The lower bound of integration.
+ * @param upper The upper bound of integration.
+ * @param opts The tolerances and limits of the integration.
+ * @return The integral and an estimate of its error.
+ * @throws std::invalid_argument if the integrand has more than one variable, or if a bound is not
+ * finite.
+ */
+auto Quadrature(const CompiledExpression& integrand, double lower, double upper, const QuadratureOpts& opts = {}) -> QuadratureResult;
+
+/**
+ * Evaluates a definite integral to a number.
+ *
+ * When the integrand is bounded on the interval, it is integrated symbolically when possible, and
+ * the antiderivative evaluated at the bounds. When the integrand may be unbounded on the interval,
+ * when there is no antiderivative, or when it is not finite at the bounds, the integrand is
+ * integrated numerically with Quadrature.
+ *
+ * @param integrand The expression to integrate.
+ * @param variable The variable of integration.
+ * @param lower The lower bound of integration, which must simplify to a real number.
+ * @param upper The upper bound of integration, which must simplify to a real number.
+ * @param opts The tolerances and limits of numeric integration.
+ * @return The integral and an estimate of its error, or an error if a bound is not a number or the
+ * integrand depends on another variable.
+ */
+auto EvaluateDefiniteIntegral(const Expression& integrand, const Variable& variable, const Expression& lower, const Expression& upper, const QuadratureOpts& opts = {}) -> std::expected<QuadratureResult, std::string>;
+
+} // Oasis
+
+#endif // OASIS_QUADRATURE_HPP
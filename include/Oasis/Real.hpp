@@ -21,6 +21,8 @@ public:
 
     [[nodiscard]] auto Equals(const Expression& other) const -> bool final;
 
+    [[nodiscard]] auto Hash() const -> std::size_t final;
+
     EXPRESSION_TYPE(Real)
     EXPRESSION_CATEGORY(UnExp)
 
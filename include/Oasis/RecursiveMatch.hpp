@@ -0,0 +1,287 @@
+//
+// Created by agent on 10/17/26.
+//
+
+#ifndef OASIS_RECURSIVEMATCH_HPP
+#define OASIS_RECURSIVEMATCH_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+template <IExpression T>
+class MatchView;
+
+/**
+ * A pattern that binds to a MatchView rather than directly to an expression.
+ * @note This class is not intended to be used directly by end users.
+ */
+template <typename T>
+concept CompositePattern = DerivedFromBinaryExpression<T> || DerivedFromUnaryExpression<T>;
+
+/**
+ * What an operand of a pattern binds to: a view for binary and unary patterns, or a pointer into
+ * the matched expression for leaves and `Expression`.
+ * @note This class is not intended to be used directly by end users.
+ */
+template <IExpression T>
+using MatchSlot = std::conditional_t<CompositePattern<T>, MatchView<T>, const T*>;
+
+/**
+ * Binds an expression to a slot of pattern T.
+ * @note This function is not intended to be used directly by end users.
+ *
+ * @param expression The expression to bind.
+ * @param slot The slot to bind the expression to.
+ * @return Whether the expression matches T.
+ */
+template <IExpression T>
+auto BindMatch(const Expression& expression, MatchSlot<T>& slot) -> bool
+{
+    if constexpr (CompositePattern<T>) {
+        return slot.Bind(expression);
+    } else if constexpr (std::is_same_v<T, Expression>) {
+        slot = &expression;
+        return true;
+    } else {
+        // Leaves are not specialized, so a leaf of type T is a T.
+        if (!expression.Is<T>()) {
+            return false;
+        }
+
+        slot = static_cast<const T*>(&expression);
+        return true;
+    }
+}
+
+/**
+ * Gets the binding held by a slot of pattern T.
+ * @note This function is not intended to be used directly by end users.
+ */
+template <IExpression T>
+auto GetMatch(const MatchSlot<T>& slot) -> std::conditional_t<CompositePattern<T>, const MatchView<T>&, const T&>
+{
+    if constexpr (CompositePattern<T>) {
+        return slot;
+    } else {
+        return *slot;
+    }
+}
+
+/**
+ * A non-owning view of an expression that matched a binary pattern such as `Add<Real, Multiply<Real, Variable>>`.
+ *
+ * The operands of the view are references into the matched expression, or nested views for nested
+ * patterns, so a view may not outlive the expression it was matched against. A view behaves like a
+ * pointer to the matched pattern: it compares equal to nullptr if the match failed, and its
+ * operands are accessed through `->`.
+ *
+ * @tparam DerivedT The type of the binary expression.
+ * @tparam MostSigOpT The pattern of the most significant operand.
+ * @tparam LeastSigOpT The pattern of the least significant operand.
+ */
+template <template <typename, typename> typename DerivedT, IExpression MostSigOpT, IExpression LeastSigOpT>
+    requires DerivedFromBinaryExpression<DerivedT<MostSigOpT, LeastSigOpT>>
+class MatchView<DerivedT<MostSigOpT, LeastSigOpT>> {
+public:
+    /**
+     * Binds this view to an expression, considering the commutative property.
+     * @note This function is not intended to be used directly by end users.
+     *
+     * @param other The expression to match.
+     * @return Whether the expression matches.
+     */
+    auto Bind(const Expression& other) -> bool
+    {
+        expression = nullptr;
+
+        if (!other.template Is<DerivedT>()) {
+            return false;
+        }
+
+        const Expression* first = other.GetOperandAt(0);
+        const Expression* second = other.GetOperandAt(1);
+
+        if (!first || !second) {
+            return false;
+        }
+
+        if (BindMatch<MostSigOpT>(*first, mostSigOp) && BindMatch<LeastSigOpT>(*second, leastSigOp)) {
+            expression = &other;
+            return true;
+        }
+
+        if (!(other.GetCategory() & Commutative)) {
+            return false;
+        }
+
+        if (BindMatch<MostSigOpT>(*second, mostSigOp) && BindMatch<LeastSigOpT>(*first, leastSigOp)) {
+            expression = &other;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Gets the matched expression.
+     * @return The matched expression.
+     */
+    [[nodiscard]] auto GetExpression() const -> const Expression&
+    {
+        return *expression;
+    }
+
+    /**
+     * Gets the binding of the most significant operand.
+     * @return The binding of the most significant operand.
+     */
+    [[nodiscard]] auto GetMostSigOp() const -> decltype(auto)
+    {
+        return GetMatch<MostSigOpT>(mostSigOp);
+    }
+
+    /**
+     * Gets the binding of the least significant operand.
+     * @return The binding of the least significant operand.
+     */
+    [[nodiscard]] auto GetLeastSigOp() const -> decltype(auto)
+    {
+        return GetMatch<LeastSigOpT>(leastSigOp);
+    }
+
+    explicit operator bool() const
+    {
+        return expression != nullptr;
+    }
+
+    auto operator==(std::nullptr_t) const -> bool
+    {
+        return expression == nullptr;
+    }
+
+    auto operator->() const -> const MatchView*
+    {
+        return this;
+    }
+
+private:
+    const Expression* expression = nullptr;
+    MatchSlot<MostSigOpT> mostSigOp {};
+    MatchSlot<LeastSigOpT> leastSigOp {};
+};
+
+/**
+ * A non-owning view of an expression that matched a unary pattern such as `Negate<Variable>`.
+ * @see MatchView<DerivedT<MostSigOpT, LeastSigOpT>>
+ *
+ * @tparam DerivedT The type of the unary expression.
+ * @tparam OperandT The pattern of the operand.
+ */
+template <template <typename> typename DerivedT, IExpression OperandT>
+    requires(DerivedFromUnaryExpression<DerivedT<OperandT>> && !DerivedFromBinaryExpression<DerivedT<OperandT>>)
+class MatchView<DerivedT<OperandT>> {
+public:
+    /**
+     * Binds this view to an expression.
+     * @note This function is not intended to be used directly by end users.
+     *
+     * @param other The expression to match.
+     * @return Whether the expression matches.
+     */
+    auto Bind(const Expression& other) -> bool
+    {
+        expression = nullptr;
+
+        if (!other.template Is<DerivedT>()) {
+            return false;
+        }
+
+        const Expression* first = other.GetOperandAt(0);
+        if (!first || !BindMatch<OperandT>(*first, operand)) {
+            return false;
+        }
+
+        expression = &other;
+        return true;
+    }
+
+    /**
+     * Gets the matched expression.
+     * @return The matched expression.
+     */
+    [[nodiscard]] auto GetExpression() const -> const Expression&
+    {
+        return *expression;
+    }
+
+    /**
+     * Gets the binding of the operand.
+     * @return The binding of the operand.
+     */
+    [[nodiscard]] auto GetOperand() const -> decltype(auto)
+    {
+        return GetMatch<OperandT>(operand);
+    }
+
+    explicit operator bool() const
+    {
+        return expression != nullptr;
+    }
+
+    auto operator==(std::nullptr_t) const -> bool
+    {
+        return expression == nullptr;
+    }
+
+    auto operator->() const -> const MatchView*
+    {
+        return this;
+    }
+
+private:
+    const Expression* expression = nullptr;
+    MatchSlot<OperandT> operand {};
+};
+
+/**
+ * Matches an expression against a binary or unary pattern without allocating.
+ *
+ * Unlike RecursiveCast, which builds a specialized copy of the expression, RecursiveMatch binds the
+ * operands of the pattern to references into the expression. Like RecursiveCast, it considers the
+ * commutative property.
+ *
+ * @tparam T The pattern to match, e.g. `Add<Real, Multiply<Real, Expression>>`.
+ * @param other The expression to match.
+ * @return A view of the match, which compares equal to nullptr if the expression does not match.
+ */
+template <IExpression T>
+    requires CompositePattern<T>
+auto RecursiveMatch(const Expression& other) -> MatchView<T>
+{
+    MatchView<T> view;
+    view.Bind(other);
+    return view;
+}
+
+/**
+ * Matches an expression against a leaf pattern without allocating.
+ *
+ * @tparam T The leaf type to match, or `Expression` to match anything.
+ * @param other The expression to match.
+ * @return The expression as a T, or nullptr if the expression is not a T.
+ */
+template <IExpression T>
+    requires(!CompositePattern<T>)
+auto RecursiveMatch(const Expression& other) -> const T*
+{
+    const T* match = nullptr;
+    return BindMatch<T>(other, match) ? match : nullptr;
+}
+
+} // Oasis
+
+#endif // OASIS_RECURSIVEMATCH_HPP
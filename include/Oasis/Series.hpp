@@ -0,0 +1,55 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_SERIES_HPP
+#define OASIS_SERIES_HPP
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class Variable;
+
+/**
+ * Computes the Taylor coefficients of an expression about a point.
+ *
+ * The expression is evaluated once, bottom up, in truncated power series arithmetic: every
+ * subexpression becomes its first `order + 1` coefficients, products and quotients are formed by
+ * convolution, and powers, exponentials, logarithms, and sines by their recurrences. No derivative
+ * expression is built or simplified, and the cost grows with the square of the order.
+ *
+ * Sums, differences, products, quotients, powers, logarithms, sines, negations, magnitudes, real
+ * numbers, pi, and Euler's number are supported.
+ *
+ * @param expression The expression to expand.
+ * @param variable The variable to expand in. It must be the only variable of the expression.
+ * @param point The point to expand about.
+ * @param order The highest power of the series.
+ * @return The coefficient of (variable - point)^k at index k, or an error if the expression has
+ * another variable, contains an unsupported subexpression, or is not analytic at the point.
+ */
+auto SeriesCoefficients(const Expression& expression, const Variable& variable, double point, std::size_t order) -> std::expected<std::vector<double>, std::string>;
+
+/**
+ * Computes the Taylor polynomial of an expression about a point.
+ * @see SeriesCoefficients
+ *
+ * @param expression The expression to expand.
+ * @param variable The variable to expand in. It must be the only variable of the expression.
+ * @param point The point to expand about, which must simplify to a real number.
+ * @param order The highest power of the polynomial.
+ * @return The sum of c_k (variable - point)^k over the nonzero coefficients, lowest power first, or
+ * an error if the series cannot be computed.
+ */
+auto Series(const Expression& expression, const Variable& variable, const Expression& point, std::size_t order) -> std::expected<std::unique_ptr<Expression>, std::string>;
+
+} // Oasis
+
+#endif // OASIS_SERIES_HPP
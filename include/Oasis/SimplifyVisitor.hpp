@@ -5,10 +5,13 @@
 #ifndef SIMPLIFYVISITOR_HPP
 #define SIMPLIFYVISITOR_HPP
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <gsl-lite/gsl-lite.hpp>
 
+#include "Oasis/ExpressionCache.hpp"
 #include "Oasis/Visit.hpp"
 
 namespace Oasis {
@@ -25,6 +28,14 @@ struct SimplifyOpts {
         DEFAULT,
     } distributivePolicy
         = DistributivePolicy::DEFAULT;
+
+    /**
+     * The maximum number of simplified subexpressions a visitor remembers. When nonzero, the
+     * visitor caches the result of every composite expression it simplifies, so simplifying an
+     * expression equal to one seen before is a lookup. The least recently used result is evicted
+     * when the cache is full. Zero disables the cache.
+     */
+    std::size_t memoCapacity = 0;
 };
 
 class SimplifyVisitor final : public TypedVisitor<std::expected<gsl_lite::not_null<std::unique_ptr<Expression>>, std::string>> {
@@ -53,8 +64,46 @@ public:
 
     [[nodiscard]] SimplifyOpts GetOptions() const;
 
+    /**
+     * Gets the number of simplified subexpressions this visitor has cached.
+     * @return The number of cached results, which is zero if the cache is disabled.
+     */
+    [[nodiscard]] auto GetMemoSize() const -> std::size_t;
+
+    /**
+     * Shares the common subexpressions of an expression, then simplifies it, simplifying each
+     * shared subexpression once. Prefer this to visiting an expression that repeats large
+     * subexpressions, such as a derivative.
+     * @param expression The expression to simplify.
+     * @return The simplified expression.
+     */
+    auto SimplifyShared(const Expression& expression) -> RetT;
+
 private:
+    template <typename T>
+    auto Memoize(const T& expression) -> RetT;
+
+    auto Simplify(const Add<Expression, Expression>& add) -> RetT;
+    auto Simplify(const Subtract<Expression, Expression>& subtract) -> RetT;
+    auto Simplify(const Multiply<Expression, Expression>& multiply) -> RetT;
+    auto Simplify(const Divide<Expression, Expression>& divide) -> RetT;
+    auto Simplify(const Exponent<Expression, Expression>& exponent) -> RetT;
+    auto Simplify(const Log<Expression, Expression>& log) -> RetT;
+    auto Simplify(const Negate<Expression>& negate) -> RetT;
+    auto Simplify(const Sine<Expression>& sine) -> RetT;
+    auto Simplify(const Derivative<Expression, Expression>& derivative) -> RetT;
+    auto Simplify(const Integral<Expression, Expression>& integral) -> RetT;
+    auto Simplify(const Magnitude<Expression>& magnitude) -> RetT;
+
     SimplifyOpts options;
+
+    // Shared so that copies of a visitor share what it has learned.
+    std::shared_ptr<ExpressionCache<std::shared_ptr<const Expression>>> memo;
+
+    // Results for the nodes of the expression being simplified by SimplifyShared, keyed by address.
+    // Only its nodes are keys, and it outlives them as keys, so an address is never reused by
+    // another expression while it is a key.
+    std::unordered_map<const Expression*, std::shared_ptr<const Expression>> sharedResults;
 };
 
 } // Oasis
@@ -0,0 +1,47 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#ifndef OASIS_SUBSTITUTE_HPP
+#define OASIS_SUBSTITUTE_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class SimplifyVisitor;
+
+/**
+ * Substitutes values for any number of variables in a single traversal.
+ *
+ * Every variable whose name is a key of `values` is replaced by the corresponding value. Each value
+ * is copied once and shared by all of its occurrences, and subtrees that contain none of the
+ * variables are shared with the original expression rather than copied. The result is not
+ * simplified.
+ *
+ * @param expression The expression to substitute into.
+ * @param values The values to substitute, keyed by variable name.
+ * @return The expression with the values substituted.
+ */
+auto Substitute(const Expression& expression, const std::unordered_map<std::string, const Expression*>& values) -> std::unique_ptr<Expression>;
+
+/**
+ * Substitutes values for any number of variables in a single traversal, then simplifies the result once.
+ * @see Substitute(const Expression&, const std::unordered_map<std::string, const Expression*>&)
+ *
+ * @param expression The expression to substitute into.
+ * @param values The values to substitute, keyed by variable name.
+ * @param simplifyVisitor The visitor used to simplify the result. Reusing a visitor with a memo cache
+ * across many substitutions into the same model lets unchanged subtrees be simplified only once.
+ * @return The simplified expression with the values substituted, or the unsimplified expression if
+ * simplification fails.
+ */
+auto Substitute(const Expression& expression, const std::unordered_map<std::string, const Expression*>& values, SimplifyVisitor& simplifyVisitor) -> std::unique_ptr<Expression>;
+
+} // Oasis
+
+#endif // OASIS_SUBSTITUTE_HPP
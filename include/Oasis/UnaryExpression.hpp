@@ -5,7 +5,13 @@
 #ifndef UNARYEXPRESSION_HPP
 #define UNARYEXPRESSION_HPP
 
+#include <stdexcept>
+
 #include "Expression.hpp"
+#include "Hash.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Substitute.hpp"
+#include "Variable.hpp"
 #include "Visit.hpp"
 
 namespace Oasis {
@@ -17,14 +23,19 @@ class UnaryExpression : public Expression {
     using DerivedGeneralized = DerivedT<Expression>;
 
 public:
-    UnaryExpression() = default;
+    UnaryExpression()
+    {
+        UpdateHash();
+    }
 
+    /**
+     * Copies an expression. The copy shares the operand of the other expression.
+     */
     UnaryExpression(const UnaryExpression& other)
         : Expression(other)
+        , op(other.op)
+        , hash(other.hash)
     {
-        if (other.HasOperand()) {
-            SetOperand(other.GetOperand());
-        }
     }
 
     explicit UnaryExpression(const OperandT& operand)
@@ -39,7 +50,7 @@ public:
 
     [[nodiscard]] auto Equals(const Expression& other) const -> bool final
     {
-        if (!other.Is<DerivedSpecialized>()) {
+        if (!other.Is<DerivedSpecialized>() || Hash() != other.Hash()) {
             return false;
         }
 
@@ -52,11 +63,19 @@ public:
 
     [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression> final
     {
-        DerivedGeneralized generalized;
-        if (this->op) {
-            generalized.SetOperand(*this->op->Copy());
-        }
-        return std::make_unique<DerivedGeneralized>(generalized);
+        auto generalized = std::make_unique<DerivedGeneralized>();
+        generalized->SetOperand(this->op);
+        return generalized;
+    }
+
+    [[nodiscard]] auto Hash() const -> std::size_t final
+    {
+        return hash;
+    }
+
+    [[nodiscard]] auto GetOperandAt(std::size_t index) const -> const Expression* final
+    {
+        return index == 0 ? op.get() : nullptr;
     }
 
     auto GetOperand() const -> const OperandT&
@@ -64,6 +83,15 @@ public:
         return *op;
     }
 
+    /**
+     * Gets the operand of this expression without copying it.
+     * @return A shared pointer to the operand, or nullptr if it is not set.
+     */
+    auto GetOperandPtr() const -> std::shared_ptr<const OperandT>
+    {
+        return op;
+    }
+
     auto HasOperand() const -> bool
     {
         return op != nullptr;
@@ -79,27 +107,69 @@ public:
         if constexpr (std::same_as<OperandT, Expression>) {
             this->op = operand.Copy();
         } else {
-            this->op = std::make_unique<OperandT>(operand);
+            this->op = std::make_shared<OperandT>(operand);
         }
+        UpdateHash();
+    }
+
+    /**
+     * Sets the operand of this expression, sharing it rather than copying it.
+     * @param operand The operand to share.
+     */
+    auto SetOperand(std::shared_ptr<const OperandT> operand) -> void
+    {
+        this->op = std::move(operand);
+        UpdateHash();
     }
 
     auto Substitute(const Expression& var, const Expression& val) -> std::unique_ptr<Expression> override
     {
-        std::unique_ptr<Expression> right = ((GetOperand().Copy())->Substitute(var, val));
-        DerivedT<Expression> comb = DerivedT<Expression> { *right };
-        //        auto ret = comb.Accept();
-        return comb.Generalize();
+        if (!var.Is<Variable>()) {
+            throw std::invalid_argument("Variable was not a variable.");
+        }
+
+        Oasis::SimplifyVisitor simplifyVisitor {};
+        return Oasis::Substitute(*this, { { static_cast<const Variable&>(var).GetName(), &val } }, simplifyVisitor);
     }
 
     auto AcceptInternal(Visitor& visitor) const -> any override
     {
-        const auto generalized = Generalize();
-        const auto& derivedGeneralized = dynamic_cast<const DerivedGeneralized&>(*generalized);
-        return visitor.Visit(derivedGeneralized);
+        return WithGeneralized([&visitor](const DerivedGeneralized& generalized) { return visitor.Visit(generalized); });
+    }
+
+    auto AcceptInternal(TypedVisitorBase& visitor) const -> void override
+    {
+        WithGeneralized([&visitor](const DerivedGeneralized& generalized) { visitor.Dispatch(generalized); });
     }
 
 protected:
-    std::unique_ptr<OperandT> op;
+    std::shared_ptr<const OperandT> op;
+
+private:
+    /**
+     * Invokes a function on the generalized form of this expression.
+     *
+     * The generalized view of a specialized expression shares its operand, so this does not copy
+     * the subtree.
+     */
+    template <typename FnT>
+    auto WithGeneralized(FnT&& fn) const -> decltype(auto)
+    {
+        if constexpr (std::same_as<DerivedSpecialized, DerivedGeneralized>) {
+            return fn(static_cast<const DerivedGeneralized&>(*this));
+        } else {
+            DerivedGeneralized generalized;
+            generalized.SetOperand(std::shared_ptr<const Expression> { this->op });
+            return fn(std::as_const(generalized));
+        }
+    }
+
+    auto UpdateHash() -> void
+    {
+        hash = HashCombine(HashType(DerivedGeneralized::GetStaticType()), op ? op->Hash() : 0);
+    }
+
+    std::size_t hash = 0;
 };
 
 } // Oasis
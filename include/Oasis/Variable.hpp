@@ -36,6 +36,8 @@ public:
 
     [[nodiscard]] virtual auto Equals(const Expression& other) const -> bool final;
 
+    [[nodiscard]] auto Hash() const -> std::size_t final;
+
     EXPRESSION_TYPE(Variable)
     EXPRESSION_CATEGORY(UnExp)
 
@@ -5,6 +5,9 @@
 #ifndef OASIS_SERIALIZATION_HPP
 #define OASIS_SERIALIZATION_HPP
 
+#include <optional>
+#include <utility>
+
 #include "Expression.hpp"
 #include "FwdDecls.hpp"
 
@@ -34,8 +37,40 @@ public:
     virtual ~Visitor() = default;
 };
 
+/**
+ * A visitor whose visit functions do not return a value.
+ *
+ * Expressions dispatch a TypedVisitor through this interface, which lets the visitor hand its
+ * result back to `Expression::Accept` directly instead of boxing it in an `any`.
+ *
+ * @note This class is not intended to be used directly by end users.
+ */
+class TypedVisitorBase {
+public:
+    virtual auto Dispatch(const Real& real) -> void = 0;
+    virtual auto Dispatch(const Imaginary& imaginary) -> void = 0;
+    virtual auto Dispatch(const Matrix& matrix) -> void = 0;
+    virtual auto Dispatch(const Variable& variable) -> void = 0;
+    virtual auto Dispatch(const Undefined& undefined) -> void = 0;
+    virtual auto Dispatch(const EulerNumber&) -> void = 0;
+    virtual auto Dispatch(const Pi&) -> void = 0;
+    virtual auto Dispatch(const Add<Expression, Expression>& add) -> void = 0;
+    virtual auto Dispatch(const Subtract<Expression, Expression>& subtract) -> void = 0;
+    virtual auto Dispatch(const Multiply<Expression, Expression>& multiply) -> void = 0;
+    virtual auto Dispatch(const Divide<Expression, Expression>& divide) -> void = 0;
+    virtual auto Dispatch(const Exponent<Expression, Expression>& exponent) -> void = 0;
+    virtual auto Dispatch(const Log<Expression, Expression>& log) -> void = 0;
+    virtual auto Dispatch(const Negate<Expression>& negate) -> void = 0;
+    virtual auto Dispatch(const Sine<Expression>& sine) -> void = 0;
+    virtual auto Dispatch(const Magnitude<Expression>& magnitude) -> void = 0;
+    virtual auto Dispatch(const Derivative<Expression, Expression>& derivative) -> void = 0;
+    virtual auto Dispatch(const Integral<Expression, Expression>& integral) -> void = 0;
+
+    virtual ~TypedVisitorBase() = default;
+};
+
 template <typename T>
-class TypedVisitor : public Visitor {
+class TypedVisitor : public Visitor, public TypedVisitorBase {
 public:
     using RetT = T;
 
@@ -58,6 +93,25 @@ public:
     auto Visit(const Derivative<Expression, Expression>& derivative) -> any final { return TypedVisit(derivative); }
     auto Visit(const Integral<Expression, Expression>& integral) -> any final { return TypedVisit(integral); }
 
+    auto Dispatch(const Real& real) -> void final { result.emplace(TypedVisit(real)); }
+    auto Dispatch(const Imaginary& imaginary) -> void final { result.emplace(TypedVisit(imaginary)); }
+    auto Dispatch(const Matrix& matrix) -> void final { result.emplace(TypedVisit(matrix)); }
+    auto Dispatch(const Variable& variable) -> void final { result.emplace(TypedVisit(variable)); }
+    auto Dispatch(const Undefined& undefined) -> void final { result.emplace(TypedVisit(undefined)); }
+    auto Dispatch(const EulerNumber& e) -> void final { result.emplace(TypedVisit(e)); }
+    auto Dispatch(const Pi& pi) -> void final { result.emplace(TypedVisit(pi)); }
+    auto Dispatch(const Add<Expression, Expression>& add) -> void final { result.emplace(TypedVisit(add)); }
+    auto Dispatch(const Subtract<Expression, Expression>& subtract) -> void final { result.emplace(TypedVisit(subtract)); }
+    auto Dispatch(const Multiply<Expression, Expression>& multiply) -> void final { result.emplace(TypedVisit(multiply)); }
+    auto Dispatch(const Divide<Expression, Expression>& divide) -> void final { result.emplace(TypedVisit(divide)); }
+    auto Dispatch(const Exponent<Expression, Expression>& exponent) -> void final { result.emplace(TypedVisit(exponent)); }
+    auto Dispatch(const Log<Expression, Expression>& log) -> void final { result.emplace(TypedVisit(log)); }
+    auto Dispatch(const Negate<Expression>& negate) -> void final { result.emplace(TypedVisit(negate)); }
+    auto Dispatch(const Sine<Expression>& sine) -> void final { result.emplace(TypedVisit(sine)); }
+    auto Dispatch(const Magnitude<Expression>& magnitude) -> void final { result.emplace(TypedVisit(magnitude)); }
+    auto Dispatch(const Derivative<Expression, Expression>& derivative) -> void final { result.emplace(TypedVisit(derivative)); }
+    auto Dispatch(const Integral<Expression, Expression>& integral) -> void final { result.emplace(TypedVisit(integral)); }
+
 protected:
     virtual auto TypedVisit(const Real& real) -> RetT = 0;
     virtual auto TypedVisit(const Imaginary& imaginary) -> RetT = 0;
@@ -77,6 +131,23 @@ protected:
     virtual auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT = 0;
     virtual auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT = 0;
     virtual auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT = 0;
+
+private:
+    friend class Expression;
+
+    /**
+     * Moves the result of the most recent dispatch out of this visitor.
+     *
+     * Results are taken as soon as the dispatch returns, so visitors that accept operands from
+     * within `TypedVisit` do not clobber each other's results.
+     */
+    auto TakeResult() -> RetT
+    {
+        auto taken = std::exchange(result, std::nullopt);
+        return std::move(*taken);
+    }
+
+    std::optional<RetT> result;
 };
 
 }
@@ -573,7 +573,7 @@ auto ParseBinaryOperationAssociativeAndCommutative(const std::string_view token,
         return std::unexpected { elements.error() };
     }
 
-    return Oasis::BuildFromVector<T>(*elements);
+    return Oasis::BuildFromVector<T>(std::move(*elements));
 }
 
 template <template <typename, typename> typename T>
@@ -65,8 +65,8 @@ auto Add<Expression>::Integrate(const Expression& integrationVariable) const ->
 auto Add<Expression>::Differentiate(const Expression& differentiationVariable) const -> std::unique_ptr<Expression>
 {
     if (auto variable = RecursiveCast<Variable>(differentiationVariable); variable != nullptr) {
-        auto left = mostSigOp->Differentiate(differentiationVariable);
-        auto right = leastSigOp->Differentiate(differentiationVariable);
+        auto left = GetMostSigOp().Differentiate(differentiationVariable);
+        auto right = GetLeastSigOp().Differentiate(differentiationVariable);
         SimplifyVisitor simplifyVisitor;
         auto simplified = Add<Expression> { *left, *right }.Accept(simplifyVisitor);
         if (!simplified) {
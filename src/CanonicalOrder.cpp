@@ -0,0 +1,212 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <algorithm>
+#include <vector>
+
+#include "Oasis/CanonicalOrder.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    template <template <typename, typename> typename T>
+    auto TryFlattenView(const Expression& expression, std::vector<const Expression*>& out) -> bool
+    {
+        const auto* generalized = dynamic_cast<const T<Expression, Expression>*>(&expression);
+        if (!generalized) {
+            return false;
+        }
+
+        generalized->ForEachFlattened([&out](const Expression& op) { out.push_back(&op); });
+        return true;
+    }
+
+    /**
+     * Collects the operands of an associative expression, descending into operands of the same type.
+     */
+    auto FlattenOperands(const Expression& expression, std::vector<const Expression*>& out) -> void
+    {
+        if (TryFlattenView<Add>(expression, out) || TryFlattenView<Multiply>(expression, out)) {
+            return;
+        }
+
+        // Specialized expressions and other associative types are always binary.
+        for (std::size_t i = 0; const Expression* op = expression.GetOperandAt(i); ++i) {
+            if (op->GetType() == expression.GetType()) {
+                FlattenOperands(*op, out);
+            } else {
+                out.push_back(op);
+            }
+        }
+    }
+
+    auto CompareOperands(const std::vector<const Expression*>& lhs, const std::vector<const Expression*>& rhs) -> std::weak_ordering
+    {
+        return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const Expression* l, const Expression* r) {
+            return CanonicalCompare(*l, *r);
+        });
+    }
+
+    auto CompareMatrices(const Matrix& lhs, const Matrix& rhs) -> std::weak_ordering
+    {
+        const MatrixXXD lhsMatrix = lhs.GetMatrix();
+        const MatrixXXD rhsMatrix = rhs.GetMatrix();
+
+        if (auto order = lhsMatrix.rows() <=> rhsMatrix.rows(); order != 0) {
+            return order;
+        }
+
+        if (auto order = lhsMatrix.cols() <=> rhsMatrix.cols(); order != 0) {
+            return order;
+        }
+
+        return std::lexicographical_compare_three_way(lhsMatrix.data(), lhsMatrix.data() + lhsMatrix.size(), rhsMatrix.data(), rhsMatrix.data() + rhsMatrix.size(), [](double l, double r) {
+            return std::weak_order(l, r);
+        });
+    }
+
+    /**
+     * Rebuilds an expression with canonicalized operands.
+     */
+    class CanonicalizeVisitor final : public TypedVisitor<std::unique_ptr<Expression>> {
+    public:
+        auto TypedVisit(const Real& real) -> RetT override { return real.Copy(); }
+        auto TypedVisit(const Imaginary& imaginary) -> RetT override { return imaginary.Copy(); }
+        auto TypedVisit(const Variable& variable) -> RetT override { return variable.Copy(); }
+        auto TypedVisit(const Undefined& undefined) -> RetT override { return undefined.Copy(); }
+        auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override { return CanonicalizeCommutative<Add>(add); }
+        auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override { return CanonicalizeBinary<Subtract>(subtract); }
+        auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override { return CanonicalizeCommutative<Multiply>(multiply); }
+        auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override { return CanonicalizeBinary<Divide>(divide); }
+        auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override { return CanonicalizeBinary<Exponent>(exponent); }
+        auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override { return CanonicalizeBinary<Log>(log); }
+        auto TypedVisit(const Negate<Expression>& negate) -> RetT override { return CanonicalizeUnary<Negate>(negate); }
+        auto TypedVisit(const Sine<Expression>& sine) -> RetT override { return CanonicalizeUnary<Sine>(sine); }
+        auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT override { return CanonicalizeBinary<Derivative>(derivative); }
+        // The operands of an integral are an integrand and a differential, so they are never reordered.
+        auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT override { return CanonicalizeBinary<Integral>(integral); }
+        auto TypedVisit(const Matrix& matrix) -> RetT override { return matrix.Copy(); }
+        auto TypedVisit(const EulerNumber& e) -> RetT override { return e.Copy(); }
+        auto TypedVisit(const Pi& pi) -> RetT override { return pi.Copy(); }
+        auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override { return CanonicalizeUnary<Magnitude>(magnitude); }
+
+    private:
+        template <template <typename, typename> typename T>
+        auto CanonicalizeCommutative(const T<Expression, Expression>& expression) -> RetT
+        {
+            std::vector<std::unique_ptr<Expression>> ops;
+            expression.ForEachFlattened([this, &ops](const Expression& op) { ops.push_back(op.Accept(*this).value()); });
+
+            std::ranges::sort(ops, CanonicalLess {});
+
+            if (ops.size() == 1) {
+                return std::move(ops.front());
+            }
+
+            return BuildFromVector<T>(std::move(ops));
+        }
+
+        template <template <typename, typename> typename T>
+        auto CanonicalizeBinary(const T<Expression, Expression>& binary) -> RetT
+        {
+            auto canonical = std::make_unique<T<Expression, Expression>>();
+
+            if (binary.HasMostSigOp()) {
+                canonical->SetMostSigOp(std::shared_ptr<const Expression> { binary.GetMostSigOp().Accept(*this).value() });
+            }
+
+            if (binary.HasLeastSigOp()) {
+                canonical->SetLeastSigOp(std::shared_ptr<const Expression> { binary.GetLeastSigOp().Accept(*this).value() });
+            }
+
+            return canonical;
+        }
+
+        template <template <typename> typename T>
+        auto CanonicalizeUnary(const T<Expression>& unary) -> RetT
+        {
+            auto canonical = std::make_unique<T<Expression>>();
+
+            if (unary.HasOperand()) {
+                canonical->SetOperand(std::shared_ptr<const Expression> { unary.GetOperand().Accept(*this).value() });
+            }
+
+            return canonical;
+        }
+    };
+
+} // namespace
+
+auto CanonicalCompare(const Expression& lhs, const Expression& rhs) -> std::weak_ordering
+{
+    if (&lhs == &rhs) {
+        return std::weak_ordering::equivalent;
+    }
+
+    if (auto order = lhs.GetType() <=> rhs.GetType(); order != 0) {
+        return order;
+    }
+
+    // Leaves are not specialized, so a leaf of a given type is that type.
+    switch (lhs.GetType()) {
+    case ExpressionType::Real:
+        return std::weak_order(static_cast<const Real&>(lhs).GetValue(), static_cast<const Real&>(rhs).GetValue());
+    case ExpressionType::Variable:
+        return static_cast<const Variable&>(lhs).GetName() <=> static_cast<const Variable&>(rhs).GetName();
+    case ExpressionType::Matrix:
+        return CompareMatrices(static_cast<const Matrix&>(lhs), static_cast<const Matrix&>(rhs));
+    default:
+        break;
+    }
+
+    std::vector<const Expression*> lhsOperands, rhsOperands;
+
+    if (const uint32_t category = lhs.GetCategory(); (category & (Associative | Commutative)) == (Associative | Commutative)) {
+        FlattenOperands(lhs, lhsOperands);
+        FlattenOperands(rhs, rhsOperands);
+    } else {
+        for (std::size_t i = 0; const Expression* op = lhs.GetOperandAt(i); ++i) {
+            lhsOperands.push_back(op);
+        }
+
+        for (std::size_t i = 0; const Expression* op = rhs.GetOperandAt(i); ++i) {
+            rhsOperands.push_back(op);
+        }
+    }
+
+    if (lhs.GetCategory() & Commutative) {
+        std::ranges::sort(lhsOperands, CanonicalLess {});
+        std::ranges::sort(rhsOperands, CanonicalLess {});
+    }
+
+    return CompareOperands(lhsOperands, rhsOperands);
+}
+
+auto Canonicalize(const Expression& expression) -> std::unique_ptr<Expression>
+{
+    CanonicalizeVisitor visitor;
+    return expression.Accept(visitor).value();
+}
+
+} // Oasis
@@ -0,0 +1,39 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <unordered_set>
+#include <vector>
+
+#include "Oasis/CommonSubexpression.hpp"
+
+#include "Oasis/ExpressionPool.hpp"
+
+namespace Oasis {
+
+auto EliminateCommonSubexpressions(const Expression& expression) -> std::unique_ptr<Expression>
+{
+    ExpressionPool pool;
+    return pool.Intern(expression)->Copy();
+}
+
+auto CountDistinctNodes(const Expression& expression) -> std::size_t
+{
+    std::unordered_set<const Expression*> seen { &expression };
+    std::vector<const Expression*> pending { &expression };
+
+    while (!pending.empty()) {
+        const Expression* node = pending.back();
+        pending.pop_back();
+
+        for (std::size_t i = 0; const Expression* op = node->GetOperandAt(i); ++i) {
+            if (seen.insert(op).second) {
+                pending.push_back(op);
+            }
+        }
+    }
+
+    return seen.size();
+}
+
+} // Oasis
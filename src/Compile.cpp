@@ -0,0 +1,1125 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <format>
+#include <initializer_list>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "Oasis/Compile.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define OASIS_X86_KERNELS
+#endif
+
+namespace {
+
+// Expressions whose stack fits in this many values are evaluated without touching the heap.
+constexpr std::size_t INLINE_STACK_SIZE = 64;
+
+// The number of argument sets evaluated together by EvaluateBatch.
+constexpr std::size_t BATCH_SIZE = 256;
+
+/**
+ * Gets scratch space for evaluation, which is only reallocated when a larger one is needed on this
+ * thread. The space is shared by every evaluation on the thread that asks for the same type, so it
+ * must not be held across another call for that type.
+ */
+template <typename T>
+auto Scratch(std::size_t size) -> std::span<T>
+{
+    thread_local std::vector<T> scratch;
+    if (scratch.size() < size) {
+        scratch.resize(size);
+    }
+
+    return { scratch.data(), size };
+}
+
+/**
+ * Elementwise kernels over rows of the batch evaluation stack. Binary kernels store their result
+ * in the left hand side.
+ */
+struct BatchKernels {
+    void (*add)(double* lhs, const double* rhs, std::size_t count);
+    void (*subtract)(double* lhs, const double* rhs, std::size_t count);
+    void (*multiply)(double* lhs, const double* rhs, std::size_t count);
+    void (*divide)(double* lhs, const double* rhs, std::size_t count);
+    void (*negate)(double* operand, std::size_t count);
+    void (*magnitude)(double* operand, std::size_t count);
+};
+
+namespace scalar {
+
+    void Add(double* lhs, const double* rhs, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            lhs[i] += rhs[i];
+        }
+    }
+
+    void Subtract(double* lhs, const double* rhs, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            lhs[i] -= rhs[i];
+        }
+    }
+
+    void Multiply(double* lhs, const double* rhs, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            lhs[i] *= rhs[i];
+        }
+    }
+
+    void Divide(double* lhs, const double* rhs, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            lhs[i] /= rhs[i];
+        }
+    }
+
+    void Negate(double* operand, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            operand[i] = -operand[i];
+        }
+    }
+
+    void Magnitude(double* operand, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            operand[i] = std::abs(operand[i]);
+        }
+    }
+
+    constexpr BatchKernels KERNELS { Add, Subtract, Multiply, Divide, Negate, Magnitude };
+
+} // namespace scalar
+
+#ifdef OASIS_X86_KERNELS
+
+// Each instruction set gets its own copy of the kernels, compiled for that instruction set only, so
+// the library runs on any x86 processor. The remainder of each row is handled by the scalar kernels.
+
+#define OASIS_BINARY_KERNEL(NAME, TARGET, WIDTH, LOAD, STORE, OP)                     \
+    [[gnu::target(TARGET)]] void NAME(double* lhs, const double* rhs, std::size_t count) \
+    {                                                                                  \
+        std::size_t i = 0;                                                             \
+        for (; i + (WIDTH) <= count; i += (WIDTH)) {                                   \
+            STORE(lhs + i, OP(LOAD(lhs + i), LOAD(rhs + i)));                          \
+        }                                                                              \
+        scalar::NAME(lhs + i, rhs + i, count - i);                                     \
+    }
+
+#define OASIS_UNARY_KERNEL(NAME, TARGET, WIDTH, LOAD, STORE, OP)             \
+    [[gnu::target(TARGET)]] void NAME(double* operand, std::size_t count)   \
+    {                                                                        \
+        std::size_t i = 0;                                                   \
+        for (; i + (WIDTH) <= count; i += (WIDTH)) {                         \
+            STORE(operand + i, OP(LOAD(operand + i)));                       \
+        }                                                                    \
+        scalar::NAME(operand + i, count - i);                                \
+    }
+
+namespace sse2 {
+
+    [[gnu::target("sse2")]] inline auto NegatePd(__m128d operand) -> __m128d { return _mm_xor_pd(operand, _mm_set1_pd(-0.0)); }
+    [[gnu::target("sse2")]] inline auto MagnitudePd(__m128d operand) -> __m128d { return _mm_andnot_pd(_mm_set1_pd(-0.0), operand); }
+
+    OASIS_BINARY_KERNEL(Add, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd)
+    OASIS_BINARY_KERNEL(Subtract, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, _mm_sub_pd)
+    OASIS_BINARY_KERNEL(Multiply, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, _mm_mul_pd)
+    OASIS_BINARY_KERNEL(Divide, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, _mm_div_pd)
+    OASIS_UNARY_KERNEL(Negate, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, NegatePd)
+    OASIS_UNARY_KERNEL(Magnitude, "sse2", 2, _mm_loadu_pd, _mm_storeu_pd, MagnitudePd)
+
+    constexpr BatchKernels KERNELS { Add, Subtract, Multiply, Divide, Negate, Magnitude };
+
+} // namespace sse2
+
+namespace avx2 {
+
+    [[gnu::target("avx2")]] inline auto NegatePd(__m256d operand) -> __m256d { return _mm256_xor_pd(operand, _mm256_set1_pd(-0.0)); }
+    [[gnu::target("avx2")]] inline auto MagnitudePd(__m256d operand) -> __m256d { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), operand); }
+
+    OASIS_BINARY_KERNEL(Add, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd)
+    OASIS_BINARY_KERNEL(Subtract, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_sub_pd)
+    OASIS_BINARY_KERNEL(Multiply, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd)
+    OASIS_BINARY_KERNEL(Divide, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_div_pd)
+    OASIS_UNARY_KERNEL(Negate, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, NegatePd)
+    OASIS_UNARY_KERNEL(Magnitude, "avx2", 4, _mm256_loadu_pd, _mm256_storeu_pd, MagnitudePd)
+
+    constexpr BatchKernels KERNELS { Add, Subtract, Multiply, Divide, Negate, Magnitude };
+
+} // namespace avx2
+
+namespace avx512 {
+
+    [[gnu::target("avx512f")]] inline auto NegatePd(__m512d operand) -> __m512d
+    {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(operand), _mm512_castpd_si512(_mm512_set1_pd(-0.0))));
+    }
+
+    [[gnu::target("avx512f")]] inline auto MagnitudePd(__m512d operand) -> __m512d { return _mm512_abs_pd(operand); }
+
+    OASIS_BINARY_KERNEL(Add, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd)
+    OASIS_BINARY_KERNEL(Subtract, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_sub_pd)
+    OASIS_BINARY_KERNEL(Multiply, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_mul_pd)
+    OASIS_BINARY_KERNEL(Divide, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_div_pd)
+    OASIS_UNARY_KERNEL(Negate, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, NegatePd)
+    OASIS_UNARY_KERNEL(Magnitude, "avx512f", 8, _mm512_loadu_pd, _mm512_storeu_pd, MagnitudePd)
+
+    constexpr BatchKernels KERNELS { Add, Subtract, Multiply, Divide, Negate, Magnitude };
+
+} // namespace avx512
+
+#undef OASIS_BINARY_KERNEL
+#undef OASIS_UNARY_KERNEL
+
+#endif // OASIS_X86_KERNELS
+
+/**
+ * Selects the kernels for the widest instruction set this processor supports.
+ */
+auto SelectBatchKernels() -> const BatchKernels&
+{
+#ifdef OASIS_X86_KERNELS
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+        return avx512::KERNELS;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        return avx2::KERNELS;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return sse2::KERNELS;
+    }
+#endif
+
+    return scalar::KERNELS;
+}
+
+/**
+ * Interval arithmetic for EvaluateInterval. Bounds are computed to nearest and then rounded
+ * outward by one unit in the last place, which covers the rounding of the arithmetic and the error
+ * of the math library functions used.
+ */
+namespace interval {
+
+    using Oasis::Interval;
+
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    constexpr Interval ENTIRE { -INF, INF };
+
+    // A bound that is not a number, such as from 0 * inf, becomes unbounded.
+    auto Down(double bound) -> double
+    {
+        return std::isnan(bound) ? -INF : std::nextafter(bound, -INF);
+    }
+
+    auto Up(double bound) -> double
+    {
+        return std::isnan(bound) ? INF : std::nextafter(bound, INF);
+    }
+
+    auto Hull(std::initializer_list<double> bounds) -> Interval
+    {
+        if (std::ranges::any_of(bounds, [](double bound) { return std::isnan(bound); })) {
+            return ENTIRE;
+        }
+
+        const auto [lower, upper] = std::ranges::minmax(bounds);
+        return { Down(lower), Up(upper) };
+    }
+
+    auto Add(Interval lhs, Interval rhs) -> Interval
+    {
+        return { Down(lhs.lower + rhs.lower), Up(lhs.upper + rhs.upper) };
+    }
+
+    auto Subtract(Interval lhs, Interval rhs) -> Interval
+    {
+        return { Down(lhs.lower - rhs.upper), Up(lhs.upper - rhs.lower) };
+    }
+
+    auto Multiply(Interval lhs, Interval rhs) -> Interval
+    {
+        return Hull({ lhs.lower * rhs.lower, lhs.lower * rhs.upper, lhs.upper * rhs.lower, lhs.upper * rhs.upper });
+    }
+
+    auto Divide(Interval lhs, Interval rhs) -> Interval
+    {
+        if (rhs.Contains(0.0)) {
+            return ENTIRE;
+        }
+
+        return Hull({ lhs.lower / rhs.lower, lhs.lower / rhs.upper, lhs.upper / rhs.lower, lhs.upper / rhs.upper });
+    }
+
+    auto Negate(Interval operand) -> Interval
+    {
+        return { -operand.upper, -operand.lower };
+    }
+
+    auto Magnitude(Interval operand) -> Interval
+    {
+        if (operand.lower >= 0.0) {
+            return operand;
+        }
+
+        if (operand.upper <= 0.0) {
+            return Negate(operand);
+        }
+
+        return { 0.0, std::max(-operand.lower, operand.upper) };
+    }
+
+    auto Pow(Interval base, Interval power) -> Interval
+    {
+        // An integer power is defined for every base, and monotonic on each side of zero.
+        if (power.lower == power.upper && power.lower == std::trunc(power.lower)) {
+            const double p = power.lower;
+            if (p == 0.0) {
+                return { 1.0, 1.0 };
+            }
+
+            if (p < 0.0) {
+                return Divide({ 1.0, 1.0 }, Pow(base, { -p, -p }));
+            }
+
+            if (std::fmod(p, 2.0) == 1.0 || base.lower >= 0.0) {
+                return { Down(std::pow(base.lower, p)), Up(std::pow(base.upper, p)) };
+            }
+
+            if (base.upper <= 0.0) {
+                return { Down(std::pow(base.upper, p)), Up(std::pow(base.lower, p)) };
+            }
+
+            return { 0.0, Up(std::max(std::pow(base.lower, p), std::pow(base.upper, p))) };
+        }
+
+        // Negative bases only have real powers at integers, which are not bounded by the corners.
+        if (base.upper < 0.0 || (base.lower < 0.0 && std::floor(power.upper) >= std::ceil(power.lower))) {
+            return ENTIRE;
+        }
+
+        // On nonnegative bases, a^b is monotonic in each of a and b, so its extremes are at corners.
+        const double lower = std::max(base.lower, 0.0);
+        return Hull({ std::pow(lower, power.lower), std::pow(lower, power.upper), std::pow(base.upper, power.lower), std::pow(base.upper, power.upper) });
+    }
+
+    auto Ln(Interval argument) -> Interval
+    {
+        if (argument.upper <= 0.0) {
+            return ENTIRE;
+        }
+
+        return { argument.lower <= 0.0 ? -INF : Down(std::log(argument.lower)), Up(std::log(argument.upper)) };
+    }
+
+    auto Sine(Interval operand) -> Interval
+    {
+        constexpr double HALF_PI = std::numbers::pi / 2.0;
+        constexpr double TWO_PI = 2.0 * std::numbers::pi;
+
+        if (!std::isfinite(operand.lower) || !std::isfinite(operand.upper) || operand.upper - operand.lower >= TWO_PI) {
+            return { -1.0, 1.0 };
+        }
+
+        double lower = std::min(std::sin(operand.lower), std::sin(operand.upper));
+        double upper = std::max(std::sin(operand.lower), std::sin(operand.upper));
+
+        // Between its extremes at pi/2 + 2k pi and -pi/2 + 2k pi, sine is monotonic. Extremes are
+        // looked for with some slack, since taking one that is not there only loosens the bound.
+        const double slack = 4.0 * std::numeric_limits<double>::epsilon() * std::max({ 1.0, std::abs(operand.lower), std::abs(operand.upper) });
+        const double first = std::floor((operand.lower - HALF_PI) / TWO_PI);
+        for (double k = first; k <= first + 3.0; ++k) {
+            const double maximum = HALF_PI + k * TWO_PI;
+            const double minimum = maximum - std::numbers::pi;
+            if (operand.lower - slack <= maximum && maximum <= operand.upper + slack) {
+                upper = 1.0;
+            }
+            if (operand.lower - slack <= minimum && minimum <= operand.upper + slack) {
+                lower = -1.0;
+            }
+        }
+
+        return { std::max(-1.0, Down(lower)), std::min(1.0, Up(upper)) };
+    }
+
+} // namespace interval
+
+}
+
+namespace Oasis {
+
+/**
+ * Lowers an expression to bytecode. Each visit emits the code for a subexpression and yields the
+ * stack depth that code needs.
+ */
+class Compiler final : public TypedVisitor<std::expected<std::size_t, std::string>> {
+public:
+    using OpCode = CompiledExpression::OpCode;
+
+    Compiler(CompiledExpression& compiled, std::span<const Variable> variables)
+        : compiled(compiled)
+    {
+        for (std::size_t i = 0; i < variables.size(); ++i) {
+            indices.try_emplace(variables[i].GetName(), static_cast<std::uint32_t>(i));
+        }
+    }
+
+    auto TypedVisit(const Real& real) -> RetT override { return EmitConstant(real.GetValue(), { real.GetValue(), real.GetValue() }); }
+
+    // Pi and e are irrational, so their values are rounded, and their bounds are widened to cover them.
+    auto TypedVisit(const Pi&) -> RetT override { return EmitConstant(Pi::GetValue(), { interval::Down(Pi::GetValue()), interval::Up(Pi::GetValue()) }); }
+    auto TypedVisit(const EulerNumber&) -> RetT override { return EmitConstant(EulerNumber::GetValue(), { interval::Down(EulerNumber::GetValue()), interval::Up(EulerNumber::GetValue()) }); }
+
+    auto TypedVisit(const Variable& variable) -> RetT override
+    {
+        auto it = indices.find(variable.GetName());
+        if (it == indices.end()) {
+            return std::unexpected { std::format("Unknown variable {}.", variable.GetName()) };
+        }
+
+        compiled.code.push_back({ OpCode::Load, it->second });
+        return 1;
+    }
+
+    auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override { return EmitBinary(add, OpCode::Add); }
+    auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override { return EmitBinary(subtract, OpCode::Subtract); }
+    auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override { return EmitBinary(multiply, OpCode::Multiply); }
+    auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override { return EmitBinary(divide, OpCode::Divide); }
+    auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override { return EmitBinary(exponent, OpCode::Exponent); }
+    auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override { return EmitBinary(log, OpCode::Log); }
+    auto TypedVisit(const Negate<Expression>& negate) -> RetT override { return EmitUnary(negate, OpCode::Negate); }
+    auto TypedVisit(const Sine<Expression>& sine) -> RetT override { return EmitUnary(sine, OpCode::Sine); }
+    auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override { return EmitUnary(magnitude, OpCode::Magnitude); }
+
+    auto TypedVisit(const Imaginary&) -> RetT override { return std::unexpected { "Imaginary numbers cannot be compiled." }; }
+    auto TypedVisit(const Undefined&) -> RetT override { return std::unexpected { "Undefined expressions cannot be compiled." }; }
+    auto TypedVisit(const Matrix&) -> RetT override { return std::unexpected { "Matrices cannot be compiled." }; }
+    auto TypedVisit(const Derivative<Expression, Expression>&) -> RetT override { return std::unexpected { "Derivatives cannot be compiled." }; }
+    auto TypedVisit(const Integral<Expression, Expression>&) -> RetT override { return std::unexpected { "Integrals cannot be compiled." }; }
+
+    static auto Compile(const Expression& expression, std::span<const Variable> variables) -> std::expected<CompiledExpression, std::string>
+    {
+        CompiledExpression compiled;
+        compiled.variableCount = variables.size();
+
+        Compiler compiler { compiled, variables };
+        auto stackSize = expression.Accept(compiler);
+        if (!stackSize) {
+            return std::unexpected { stackSize.error() };
+        }
+
+        compiled.stackSize = stackSize.value();
+        return compiled;
+    }
+
+    static auto Apply(OpCode code, double lhs, double rhs) -> double
+    {
+        switch (code) {
+        case OpCode::Add:
+            return lhs + rhs;
+        case OpCode::Subtract:
+            return lhs - rhs;
+        case OpCode::Multiply:
+            return lhs * rhs;
+        case OpCode::Divide:
+            return lhs / rhs;
+        case OpCode::Exponent:
+            return std::pow(lhs, rhs);
+        case OpCode::Log:
+            // The base is the most significant operand.
+            return std::log(rhs) / std::log(lhs);
+        default:
+            assert(false && "not a binary op code");
+            return 0.0;
+        }
+    }
+
+    static auto Apply(OpCode code, double operand) -> double
+    {
+        switch (code) {
+        case OpCode::Negate:
+            return -operand;
+        case OpCode::Sine:
+            return std::sin(operand);
+        case OpCode::Magnitude:
+            return std::abs(operand);
+        default:
+            assert(false && "not a unary op code");
+            return 0.0;
+        }
+    }
+
+    static auto ApplyInterval(OpCode code, Interval lhs, Interval rhs) -> Interval
+    {
+        switch (code) {
+        case OpCode::Add:
+            return interval::Add(lhs, rhs);
+        case OpCode::Subtract:
+            return interval::Subtract(lhs, rhs);
+        case OpCode::Multiply:
+            return interval::Multiply(lhs, rhs);
+        case OpCode::Divide:
+            return interval::Divide(lhs, rhs);
+        case OpCode::Exponent:
+            return interval::Pow(lhs, rhs);
+        case OpCode::Log:
+            // The base is the most significant operand.
+            return interval::Divide(interval::Ln(rhs), interval::Ln(lhs));
+        default:
+            assert(false && "not a binary op code");
+            return interval::ENTIRE;
+        }
+    }
+
+    static auto ApplyInterval(OpCode code, Interval operand) -> Interval
+    {
+        switch (code) {
+        case OpCode::Negate:
+            return interval::Negate(operand);
+        case OpCode::Sine:
+            return interval::Sine(operand);
+        case OpCode::Magnitude:
+            return interval::Magnitude(operand);
+        default:
+            assert(false && "not a unary op code");
+            return interval::ENTIRE;
+        }
+    }
+
+private:
+    auto EmitConstant(double value, Interval bound) -> RetT
+    {
+        compiled.code.push_back({ OpCode::Constant, static_cast<std::uint32_t>(compiled.constants.size()) });
+        compiled.constants.push_back(value);
+        compiled.constantBounds.push_back(bound);
+        return 1;
+    }
+
+    /**
+     * Gets the index of the constant loaded by the instruction `offset` places from the end of the
+     * code, if it loads a constant.
+     */
+    auto TrailingConstant(std::size_t offset) const -> std::optional<std::uint32_t>
+    {
+        if (compiled.code.size() < offset) {
+            return std::nullopt;
+        }
+
+        const auto& instruction = compiled.code[compiled.code.size() - offset];
+        return instruction.code == OpCode::Constant ? std::optional { instruction.index } : std::nullopt;
+    }
+
+    /**
+     * Replaces the trailing `count` constant instructions with a single constant.
+     */
+    auto Fold(std::size_t count, double value, Interval bound) -> RetT
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            compiled.code.pop_back();
+            compiled.constants.pop_back();
+            compiled.constantBounds.pop_back();
+        }
+
+        return EmitConstant(value, bound);
+    }
+
+    template <template <typename, typename> typename T>
+    auto EmitBinary(const T<Expression, Expression>& binary, OpCode code) -> RetT
+    {
+        if (!binary.HasMostSigOp() || !binary.HasLeastSigOp()) {
+            return std::unexpected { "Missing operand." };
+        }
+
+        auto mostSigOpDepth = binary.GetMostSigOp().Accept(*this);
+        if (!mostSigOpDepth) {
+            return mostSigOpDepth;
+        }
+
+        auto leastSigOpDepth = binary.GetLeastSigOp().Accept(*this);
+        if (!leastSigOpDepth) {
+            return leastSigOpDepth;
+        }
+
+        // The value is folded to nearest, which may lose every significant digit, such as in
+        // (1e16 + 1) - 1e16, so its bound is folded separately in interval arithmetic.
+        if (const auto lhs = TrailingConstant(2), rhs = TrailingConstant(1); lhs && rhs) {
+            const auto& constants = compiled.constants;
+            const auto& bounds = compiled.constantBounds;
+            return Fold(2, Apply(code, constants[*lhs], constants[*rhs]), ApplyInterval(code, bounds[*lhs], bounds[*rhs]));
+        }
+
+        compiled.code.push_back({ code, 0 });
+
+        // The most significant operand is held on the stack while the least significant one is evaluated.
+        return std::max(mostSigOpDepth.value(), leastSigOpDepth.value() + 1);
+    }
+
+    template <template <typename> typename T>
+    auto EmitUnary(const T<Expression>& unary, OpCode code) -> RetT
+    {
+        if (!unary.HasOperand()) {
+            return std::unexpected { "Missing operand." };
+        }
+
+        auto operandDepth = unary.GetOperand().Accept(*this);
+        if (!operandDepth) {
+            return operandDepth;
+        }
+
+        if (const auto operand = TrailingConstant(1)) {
+            return Fold(1, Apply(code, compiled.constants[*operand]), ApplyInterval(code, compiled.constantBounds[*operand]));
+        }
+
+        compiled.code.push_back({ code, 0 });
+        return operandDepth;
+    }
+
+    CompiledExpression& compiled;
+    std::unordered_map<std::string, std::uint32_t> indices;
+};
+
+auto CompiledExpression::operator()(std::span<const double> arguments) const -> double
+{
+    if (arguments.size() < variableCount) {
+        throw std::invalid_argument("Too few arguments.");
+    }
+
+    if (stackSize <= INLINE_STACK_SIZE) {
+        std::array<double, INLINE_STACK_SIZE> stack;
+        return Evaluate(arguments, stack);
+    }
+
+    return Evaluate(arguments, Scratch<double>(stackSize));
+}
+
+auto CompiledExpression::Evaluate(std::span<const double> arguments, std::span<double> stack) const -> double
+{
+    assert(arguments.size() >= variableCount);
+    assert(stack.size() >= stackSize);
+
+    // top points one past the value on top of the stack.
+    double* top = stack.data();
+
+    for (const Instruction& instruction : code) {
+        switch (instruction.code) {
+        case OpCode::Constant:
+            *top++ = constants[instruction.index];
+            break;
+        case OpCode::Load:
+            *top++ = arguments[instruction.index];
+            break;
+        case OpCode::Add:
+            --top;
+            top[-1] += top[0];
+            break;
+        case OpCode::Subtract:
+            --top;
+            top[-1] -= top[0];
+            break;
+        case OpCode::Multiply:
+            --top;
+            top[-1] *= top[0];
+            break;
+        case OpCode::Divide:
+            --top;
+            top[-1] /= top[0];
+            break;
+        case OpCode::Exponent:
+        case OpCode::Log:
+            --top;
+            top[-1] = Compiler::Apply(instruction.code, top[-1], top[0]);
+            break;
+        case OpCode::Negate:
+            top[-1] = -top[-1];
+            break;
+        case OpCode::Sine:
+            top[-1] = std::sin(top[-1]);
+            break;
+        case OpCode::Magnitude:
+            top[-1] = std::abs(top[-1]);
+            break;
+        }
+    }
+
+    return top[-1];
+}
+
+auto CompiledExpression::EvaluateBatch(std::span<const std::span<const double>> columns, std::span<double> out) const -> void
+{
+    if (columns.size() < variableCount) {
+        throw std::invalid_argument("Too few columns.");
+    }
+
+    for (std::size_t i = 0; i < variableCount; ++i) {
+        if (columns[i].size() < out.size()) {
+            throw std::invalid_argument("Column is shorter than the output.");
+        }
+    }
+
+    static const BatchKernels& kernels = SelectBatchKernels();
+
+    // Each value on the stack is a row of BATCH_SIZE lanes.
+    const std::span<double> stack = Scratch<double>(stackSize * BATCH_SIZE);
+
+    for (std::size_t begin = 0; begin < out.size(); begin += BATCH_SIZE) {
+        const std::size_t count = std::min(BATCH_SIZE, out.size() - begin);
+
+        // top points one past the row on top of the stack.
+        double* top = stack.data();
+
+        for (const Instruction& instruction : code) {
+            switch (instruction.code) {
+            case OpCode::Constant:
+                std::fill_n(top, count, constants[instruction.index]);
+                top += BATCH_SIZE;
+                break;
+            case OpCode::Load:
+                std::copy_n(columns[instruction.index].data() + begin, count, top);
+                top += BATCH_SIZE;
+                break;
+            case OpCode::Add:
+                top -= BATCH_SIZE;
+                kernels.add(top - BATCH_SIZE, top, count);
+                break;
+            case OpCode::Subtract:
+                top -= BATCH_SIZE;
+                kernels.subtract(top - BATCH_SIZE, top, count);
+                break;
+            case OpCode::Multiply:
+                top -= BATCH_SIZE;
+                kernels.multiply(top - BATCH_SIZE, top, count);
+                break;
+            case OpCode::Divide:
+                top -= BATCH_SIZE;
+                kernels.divide(top - BATCH_SIZE, top, count);
+                break;
+            case OpCode::Exponent:
+            case OpCode::Log:
+                top -= BATCH_SIZE;
+                std::transform(top - BATCH_SIZE, top - BATCH_SIZE + count, top, top - BATCH_SIZE, [&instruction](double lhs, double rhs) {
+                    return Compiler::Apply(instruction.code, lhs, rhs);
+                });
+                break;
+            case OpCode::Negate:
+                kernels.negate(top - BATCH_SIZE, count);
+                break;
+            case OpCode::Sine:
+                std::transform(top - BATCH_SIZE, top - BATCH_SIZE + count, top - BATCH_SIZE, [](double operand) { return std::sin(operand); });
+                break;
+            case OpCode::Magnitude:
+                kernels.magnitude(top - BATCH_SIZE, count);
+                break;
+            }
+        }
+
+        std::copy_n(stack.data(), count, out.data() + begin);
+    }
+}
+
+auto CompiledExpression::EvaluateGradient(std::span<const double> arguments, std::span<double> gradient) const -> double
+{
+    if (arguments.size() < variableCount) {
+        throw std::invalid_argument("Too few arguments.");
+    }
+
+    if (gradient.size() < variableCount) {
+        throw std::invalid_argument("Gradient is shorter than the number of variables.");
+    }
+
+    // Each value on the stack is a dual number: the value followed by its partial derivatives.
+    const std::size_t width = variableCount + 1;
+
+    const std::span<double> stack = Scratch<double>(stackSize * width);
+
+    // top points one past the dual number on top of the stack.
+    double* top = stack.data();
+
+    for (const Instruction& instruction : code) {
+        switch (instruction.code) {
+        case OpCode::Constant:
+            top[0] = constants[instruction.index];
+            std::fill_n(top + 1, variableCount, 0.0);
+            top += width;
+            break;
+        case OpCode::Load:
+            top[0] = arguments[instruction.index];
+            std::fill_n(top + 1, variableCount, 0.0);
+            top[1 + instruction.index] = 1.0;
+            top += width;
+            break;
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::Exponent:
+        case OpCode::Log: {
+            top -= width;
+            double* lhs = top - width;
+            const double* rhs = top;
+            const double a = lhs[0];
+            const double b = rhs[0];
+            const double value = Compiler::Apply(instruction.code, a, b);
+
+            for (std::size_t i = 1; i < width; ++i) {
+                const double da = lhs[i];
+                const double db = rhs[i];
+
+                switch (instruction.code) {
+                case OpCode::Add:
+                    lhs[i] = da + db;
+                    break;
+                case OpCode::Subtract:
+                    lhs[i] = da - db;
+                    break;
+                case OpCode::Multiply:
+                    lhs[i] = da * b + a * db;
+                    break;
+                case OpCode::Divide:
+                    lhs[i] = (da - value * db) / b;
+                    break;
+                case OpCode::Exponent:
+                    // The power rule for the base and the exponential rule for the exponent. A
+                    // term is only taken when its derivative is nonzero, so that constant powers
+                    // of negative bases and constant bases raised to variables stay finite.
+                    lhs[i] = (da != 0.0 ? b * std::pow(a, b - 1.0) * da : 0.0) + (db != 0.0 ? value * std::log(a) * db : 0.0);
+                    break;
+                case OpCode::Log:
+                    // d/dx log_a(b) = b' / (b ln a) - log_a(b) a' / (a ln a)
+                    lhs[i] = ((db != 0.0 ? db / b : 0.0) - (da != 0.0 ? value * da / a : 0.0)) / std::log(a);
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            lhs[0] = value;
+            break;
+        }
+        case OpCode::Negate:
+            std::transform(top - width, top, top - width, [](double x) { return -x; });
+            break;
+        case OpCode::Sine: {
+            double* operand = top - width;
+            const double slope = std::cos(operand[0]);
+            operand[0] = std::sin(operand[0]);
+            std::transform(operand + 1, top, operand + 1, [slope](double x) { return slope * x; });
+            break;
+        }
+        case OpCode::Magnitude: {
+            double* operand = top - width;
+            const double sign = static_cast<double>((operand[0] > 0.0) - (operand[0] < 0.0));
+            operand[0] = std::abs(operand[0]);
+            std::transform(operand + 1, top, operand + 1, [sign](double x) { return sign * x; });
+            break;
+        }
+        }
+    }
+
+    std::copy_n(stack.data() + 1, variableCount, gradient.data());
+    return stack[0];
+}
+
+auto CompiledExpression::EvaluateAdjoint(std::span<const double> arguments, std::span<double> gradient) const -> double
+{
+    if (arguments.size() < variableCount) {
+        throw std::invalid_argument("Too few arguments.");
+    }
+
+    if (gradient.size() < variableCount) {
+        throw std::invalid_argument("Gradient is shorter than the number of variables.");
+    }
+
+    // The result of every instruction, with the results it was computed from.
+    struct TapeEntry {
+        double value;
+        double adjoint;
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+        // Whether the value depends on any variable. The adjoint of a constant is never needed.
+        bool variable;
+    };
+
+    const std::span<TapeEntry> tape = Scratch<TapeEntry>(code.size());
+    const std::span<std::uint32_t> stack = Scratch<std::uint32_t>(stackSize);
+
+    // The stack holds the tape positions of the values it would hold during evaluation.
+    std::uint32_t* top = stack.data();
+
+    for (std::uint32_t k = 0; k < code.size(); ++k) {
+        const Instruction& instruction = code[k];
+        TapeEntry& entry = tape[k];
+        entry.adjoint = 0.0;
+
+        switch (instruction.code) {
+        case OpCode::Constant:
+            entry.value = constants[instruction.index];
+            entry.lhs = entry.rhs = k;
+            entry.variable = false;
+            *top++ = k;
+            break;
+        case OpCode::Load:
+            entry.value = arguments[instruction.index];
+            entry.lhs = entry.rhs = k;
+            entry.variable = true;
+            *top++ = k;
+            break;
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::Exponent:
+        case OpCode::Log:
+            entry.rhs = *--top;
+            entry.lhs = top[-1];
+            entry.value = Compiler::Apply(instruction.code, tape[entry.lhs].value, tape[entry.rhs].value);
+            entry.variable = tape[entry.lhs].variable || tape[entry.rhs].variable;
+            top[-1] = k;
+            break;
+        case OpCode::Negate:
+        case OpCode::Sine:
+        case OpCode::Magnitude:
+            entry.lhs = entry.rhs = top[-1];
+            entry.value = Compiler::Apply(instruction.code, tape[entry.lhs].value);
+            entry.variable = tape[entry.lhs].variable;
+            top[-1] = k;
+            break;
+        }
+    }
+
+    std::fill_n(gradient.data(), variableCount, 0.0);
+    tape[code.size() - 1].adjoint = 1.0;
+
+    for (std::size_t k = code.size(); k-- > 0;) {
+        const TapeEntry& entry = tape[k];
+        if (!entry.variable || entry.adjoint == 0.0) {
+            continue;
+        }
+
+        const double adjoint = entry.adjoint;
+        TapeEntry& lhs = tape[entry.lhs];
+        TapeEntry& rhs = tape[entry.rhs];
+
+        // The derivative rules match EvaluateGradient. Constant operands are skipped, so that
+        // constant powers of negative bases and constant bases raised to variables stay finite.
+        switch (code[k].code) {
+        case OpCode::Constant:
+            break;
+        case OpCode::Load:
+            gradient[code[k].index] += adjoint;
+            break;
+        case OpCode::Add:
+            lhs.adjoint += adjoint;
+            rhs.adjoint += adjoint;
+            break;
+        case OpCode::Subtract:
+            lhs.adjoint += adjoint;
+            rhs.adjoint -= adjoint;
+            break;
+        case OpCode::Multiply:
+            lhs.adjoint += adjoint * rhs.value;
+            rhs.adjoint += adjoint * lhs.value;
+            break;
+        case OpCode::Divide:
+            lhs.adjoint += adjoint / rhs.value;
+            rhs.adjoint -= adjoint * entry.value / rhs.value;
+            break;
+        case OpCode::Exponent:
+            if (lhs.variable) {
+                lhs.adjoint += adjoint * rhs.value * std::pow(lhs.value, rhs.value - 1.0);
+            }
+            if (rhs.variable) {
+                rhs.adjoint += adjoint * entry.value * std::log(lhs.value);
+            }
+            break;
+        case OpCode::Log:
+            // The base is the most significant operand.
+            if (lhs.variable) {
+                lhs.adjoint -= adjoint * entry.value / (lhs.value * std::log(lhs.value));
+            }
+            if (rhs.variable) {
+                rhs.adjoint += adjoint / (rhs.value * std::log(lhs.value));
+            }
+            break;
+        case OpCode::Negate:
+            lhs.adjoint -= adjoint;
+            break;
+        case OpCode::Sine:
+            lhs.adjoint += adjoint * std::cos(lhs.value);
+            break;
+        case OpCode::Magnitude:
+            lhs.adjoint += adjoint * static_cast<double>((lhs.value > 0.0) - (lhs.value < 0.0));
+            break;
+        }
+    }
+
+    return tape[code.size() - 1].value;
+}
+
+auto CompiledExpression::EvaluateInterval(std::span<const Interval> arguments) const -> Interval
+{
+    if (arguments.size() < variableCount) {
+        throw std::invalid_argument("Too few arguments.");
+    }
+
+    const std::span<Interval> stack = Scratch<Interval>(stackSize);
+
+    // top points one past the interval on top of the stack.
+    Interval* top = stack.data();
+
+    for (const Instruction& instruction : code) {
+        switch (instruction.code) {
+        case OpCode::Constant:
+            *top++ = constantBounds[instruction.index];
+            break;
+        case OpCode::Load:
+            *top++ = arguments[instruction.index];
+            break;
+        case OpCode::Add:
+        case OpCode::Subtract:
+        case OpCode::Multiply:
+        case OpCode::Divide:
+        case OpCode::Exponent:
+        case OpCode::Log:
+            --top;
+            top[-1] = Compiler::ApplyInterval(instruction.code, top[-1], top[0]);
+            break;
+        case OpCode::Negate:
+        case OpCode::Sine:
+        case OpCode::Magnitude:
+            top[-1] = Compiler::ApplyInterval(instruction.code, top[-1]);
+            break;
+        }
+    }
+
+    return top[-1];
+}
+
+auto CompiledExpression::EvaluateIntervalBatch(std::span<const std::span<const Interval>> columns, std::span<Interval> out) const -> void
+{
+    if (columns.size() < variableCount) {
+        throw std::invalid_argument("Too few columns.");
+    }
+
+    for (std::size_t i = 0; i < variableCount; ++i) {
+        if (columns[i].size() < out.size()) {
+            throw std::invalid_argument("Column is shorter than the output.");
+        }
+    }
+
+    // Each value on the stack is a row of BATCH_SIZE lanes, as in EvaluateBatch.
+    const std::span<Interval> stack = Scratch<Interval>(stackSize * BATCH_SIZE);
+
+    for (std::size_t begin = 0; begin < out.size(); begin += BATCH_SIZE) {
+        const std::size_t count = std::min(BATCH_SIZE, out.size() - begin);
+
+        // top points one past the row on top of the stack.
+        Interval* top = stack.data();
+
+        for (const Instruction& instruction : code) {
+            switch (instruction.code) {
+            case OpCode::Constant:
+                std::fill_n(top, count, constantBounds[instruction.index]);
+                top += BATCH_SIZE;
+                break;
+            case OpCode::Load:
+                std::copy_n(columns[instruction.index].data() + begin, count, top);
+                top += BATCH_SIZE;
+                break;
+            case OpCode::Add:
+            case OpCode::Subtract:
+            case OpCode::Multiply:
+            case OpCode::Divide:
+            case OpCode::Exponent:
+            case OpCode::Log:
+                top -= BATCH_SIZE;
+                std::transform(top - BATCH_SIZE, top - BATCH_SIZE + count, top, top - BATCH_SIZE, [&instruction](Interval lhs, Interval rhs) {
+                    return Compiler::ApplyInterval(instruction.code, lhs, rhs);
+                });
+                break;
+            case OpCode::Negate:
+            case OpCode::Sine:
+            case OpCode::Magnitude:
+                std::transform(top - BATCH_SIZE, top - BATCH_SIZE + count, top - BATCH_SIZE, [&instruction](Interval operand) {
+                    return Compiler::ApplyInterval(instruction.code, operand);
+                });
+                break;
+            }
+        }
+
+        std::copy_n(stack.data(), count, out.data() + begin);
+    }
+}
+
+auto CompiledExpression::GetVariableCount() const -> std::size_t
+{
+    return variableCount;
+}
+
+auto CompiledExpression::GetStackSize() const -> std::size_t
+{
+    return stackSize;
+}
+
+auto CompiledExpression::GetInstructionCount() const -> std::size_t
+{
+    return code.size();
+}
+
+auto Compile(const Expression& expression, std::span<const Variable> variables) -> std::expected<CompiledExpression, std::string>
+{
+    return Compiler::Compile(expression, variables);
+}
+
+auto Gradient(const Expression& expression, std::span<const Variable> variables, std::span<const double> values) -> std::expected<std::vector<double>, std::string>
+{
+    if (values.size() < variables.size()) {
+        return std::unexpected { "Too few values." };
+    }
+
+    return Compile(expression, variables).transform([values](const CompiledExpression& compiled) {
+        std::vector<double> gradient(compiled.GetVariableCount());
+        compiled.EvaluateAdjoint(values, gradient);
+        return gradient;
+    });
+}
+
+} // Oasis
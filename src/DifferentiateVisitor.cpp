@@ -0,0 +1,372 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Oasis/DifferentiateVisitor.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/CommonSubexpression.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    using ExpressionPtr = std::shared_ptr<const Expression>;
+
+    template <template <typename, typename> typename T>
+    auto MakeBinary(ExpressionPtr mostSigOp, ExpressionPtr leastSigOp) -> ExpressionPtr
+    {
+        auto binary = std::make_shared<T<Expression, Expression>>();
+        binary->SetMostSigOp(std::move(mostSigOp));
+        binary->SetLeastSigOp(std::move(leastSigOp));
+        return binary;
+    }
+
+    template <template <typename> typename T>
+    auto MakeUnary(ExpressionPtr operand) -> ExpressionPtr
+    {
+        auto unary = std::make_shared<T<Expression>>();
+        unary->SetOperand(std::move(operand));
+        return unary;
+    }
+
+    // Derivatives that are identically zero are represented by nullptr, so that the terms they
+    // would contribute are never built.
+
+    auto Sum(ExpressionPtr augend, ExpressionPtr addend) -> ExpressionPtr
+    {
+        if (!augend || !addend) {
+            return augend ? augend : addend;
+        }
+
+        return MakeBinary<Add>(std::move(augend), std::move(addend));
+    }
+
+    auto Difference(ExpressionPtr minuend, ExpressionPtr subtrahend) -> ExpressionPtr
+    {
+        if (!subtrahend) {
+            return minuend;
+        }
+
+        if (!minuend) {
+            return MakeUnary<Negate>(std::move(subtrahend));
+        }
+
+        return MakeBinary<Subtract>(std::move(minuend), std::move(subtrahend));
+    }
+
+    auto NaturalLog(ExpressionPtr argument) -> ExpressionPtr
+    {
+        return MakeBinary<Log>(std::make_shared<EulerNumber>(), std::move(argument));
+    }
+
+    /**
+     * Applies the rules of differentiation to an expression whose equal subexpressions are shared,
+     * without simplifying. The derivative of each subexpression is computed once.
+     */
+    class DerivativeRules final : public TypedVisitor<std::expected<ExpressionPtr, std::string>> {
+    public:
+        explicit DerivativeRules(std::string variable)
+            : variable(std::move(variable))
+        {
+        }
+
+        auto Differentiate(const Expression& expression) -> RetT
+        {
+            // Subexpressions are shared and generalized, so each is visited in place and its
+            // address identifies it for as long as the expression lives.
+            if (auto it = memo.find(&expression); it != memo.end()) {
+                return it->second;
+            }
+
+            auto derivative = expression.Accept(*this);
+            if (derivative) {
+                memo.emplace(&expression, *derivative);
+            }
+
+            return derivative;
+        }
+
+        auto TypedVisit(const Real&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Imaginary&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Matrix&) -> RetT override { return nullptr; }
+        auto TypedVisit(const EulerNumber&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Pi&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Undefined&) -> RetT override { return std::make_shared<Undefined>(); }
+
+        auto TypedVisit(const Variable& var) -> RetT override
+        {
+            return var.GetName() == variable ? std::make_shared<Real>(1.0) : nullptr;
+        }
+
+        auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override
+        {
+            return DifferentiateBinary(add, [](const auto&, ExpressionPtr augendDerivative, const auto&, ExpressionPtr addendDerivative) {
+                return Sum(std::move(augendDerivative), std::move(addendDerivative));
+            });
+        }
+
+        auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override
+        {
+            return DifferentiateBinary(subtract, [](const auto&, ExpressionPtr minuendDerivative, const auto&, ExpressionPtr subtrahendDerivative) {
+                return Difference(std::move(minuendDerivative), std::move(subtrahendDerivative));
+            });
+        }
+
+        auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override
+        {
+            // (uv)' = u'v + uv', keeping the order of the factors
+            return DifferentiateBinary(multiply, [](const ExpressionPtr& u, ExpressionPtr du, const ExpressionPtr& v, ExpressionPtr dv) {
+                return Sum(du ? MakeBinary<Multiply>(std::move(du), v) : nullptr, dv ? MakeBinary<Multiply>(u, std::move(dv)) : nullptr);
+            });
+        }
+
+        auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override
+        {
+            // (u/v)' = (u'v - uv') / v^2
+            return DifferentiateBinary(divide, [](const ExpressionPtr& u, ExpressionPtr du, const ExpressionPtr& v, ExpressionPtr dv) -> ExpressionPtr {
+                if (!dv) {
+                    return du ? MakeBinary<Divide>(std::move(du), v) : nullptr;
+                }
+
+                auto numerator = Difference(du ? MakeBinary<Multiply>(std::move(du), v) : nullptr, MakeBinary<Multiply>(u, std::move(dv)));
+                return MakeBinary<Divide>(std::move(numerator), MakeBinary<Exponent>(v, std::make_shared<Real>(2.0)));
+            });
+        }
+
+        auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override
+        {
+            // (u^v)' = v u^(v - 1) u' when v is constant, u^v ln(u) v' when u is constant, and
+            // otherwise u^v (v u' / u + v' ln(u))
+            return DifferentiateBinary(exponent, [](const ExpressionPtr& u, ExpressionPtr du, const ExpressionPtr& v, ExpressionPtr dv) -> ExpressionPtr {
+                if (!dv) {
+                    auto reduced = v->Is<Real>()
+                        ? ExpressionPtr { std::make_shared<Real>(static_cast<const Real&>(*v).GetValue() - 1.0) }
+                        : MakeBinary<Subtract>(v, std::make_shared<Real>(1.0));
+                    return MakeBinary<Multiply>(MakeBinary<Multiply>(v, MakeBinary<Exponent>(u, std::move(reduced))), std::move(du));
+                }
+
+                auto power = MakeBinary<Exponent>(u, v);
+
+                if (!du) {
+                    auto scaled = u->Is<EulerNumber>() ? std::move(power) : MakeBinary<Multiply>(std::move(power), NaturalLog(u));
+                    return MakeBinary<Multiply>(std::move(scaled), std::move(dv));
+                }
+
+                return MakeBinary<Multiply>(std::move(power),
+                    MakeBinary<Add>(MakeBinary<Divide>(MakeBinary<Multiply>(v, std::move(du)), u), MakeBinary<Multiply>(std::move(dv), NaturalLog(u))));
+            });
+        }
+
+        auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override
+        {
+            // (log_b(u))' = u' / (u ln(b)) when b is constant, and otherwise
+            // (ln(b) u' / u - ln(u) b' / b) / ln(b)^2
+            return DifferentiateBinary(log, [](const ExpressionPtr& b, ExpressionPtr db, const ExpressionPtr& u, ExpressionPtr du) -> ExpressionPtr {
+                if (!db) {
+                    if (!du) {
+                        return nullptr;
+                    }
+
+                    return MakeBinary<Divide>(std::move(du), b->Is<EulerNumber>() ? u : MakeBinary<Multiply>(u, NaturalLog(b)));
+                }
+
+                auto lnB = NaturalLog(b);
+                auto numerator = Difference(
+                    du ? MakeBinary<Divide>(MakeBinary<Multiply>(lnB, std::move(du)), u) : nullptr,
+                    MakeBinary<Divide>(MakeBinary<Multiply>(NaturalLog(u), std::move(db)), b));
+                return MakeBinary<Divide>(std::move(numerator), MakeBinary<Exponent>(std::move(lnB), std::make_shared<Real>(2.0)));
+            });
+        }
+
+        auto TypedVisit(const Negate<Expression>& negate) -> RetT override
+        {
+            return DifferentiateUnary(negate, [](const ExpressionPtr&, ExpressionPtr du) {
+                return MakeUnary<Negate>(std::move(du));
+            });
+        }
+
+        auto TypedVisit(const Sine<Expression>& sine) -> RetT override
+        {
+            // sin(u)' = cos(u) u', where cos(u) = sin(u + pi/2) since there is no cosine expression
+            return DifferentiateUnary(sine, [](const ExpressionPtr& u, ExpressionPtr du) {
+                auto cosine = MakeUnary<Sine>(MakeBinary<Add>(u, MakeBinary<Divide>(std::make_shared<Pi>(), std::make_shared<Real>(2.0))));
+                return MakeBinary<Multiply>(std::move(cosine), std::move(du));
+            });
+        }
+
+        auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override
+        {
+            // |u|' = u u' / |u|
+            return DifferentiateUnary(magnitude, [](const ExpressionPtr& u, ExpressionPtr du) {
+                return MakeBinary<Divide>(MakeBinary<Multiply>(u, std::move(du)), MakeUnary<Magnitude>(u));
+            });
+        }
+
+        auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT override
+        {
+            if (!derivative.HasMostSigOp() || !derivative.HasLeastSigOp()) {
+                return std::unexpected { "Missing operand." };
+            }
+
+            if (!derivative.GetLeastSigOp().Is<Variable>()) {
+                return std::unexpected { "Derivatives must be taken with respect to a variable." };
+            }
+
+            // The inner derivative is taken first, then differentiated like any other expression.
+            DerivativeRules innerRules { static_cast<const Variable&>(derivative.GetLeastSigOp()).GetName() };
+            auto inner = innerRules.Differentiate(derivative.GetMostSigOp());
+            if (!inner || !*inner) {
+                return inner;
+            }
+
+            // Kept alive so that the addresses of its subexpressions stay unique while memoized.
+            const auto& shared = innerDerivatives.emplace_back(EliminateCommonSubexpressions(**inner));
+            return Differentiate(*shared);
+        }
+
+        auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT override
+        {
+            if (!integral.HasMostSigOp() || !integral.HasLeastSigOp()) {
+                return std::unexpected { "Missing operand." };
+            }
+
+            const auto integrand = integral.GetMostSigOpPtr();
+            const auto& differential = integral.GetLeastSigOp();
+
+            // The fundamental theorem of calculus
+            if (differential.Is<Variable>() && static_cast<const Variable&>(differential).GetName() == variable) {
+                return integrand;
+            }
+
+            auto integrandDerivative = Differentiate(*integrand);
+            if (!integrandDerivative || !*integrandDerivative) {
+                return integrandDerivative;
+            }
+
+            // Differentiating under the integral sign is left to the caller.
+            return MakeBinary<Derivative>(MakeBinary<Integral>(integrand, integral.GetLeastSigOpPtr()), std::make_shared<Variable>(variable));
+        }
+
+    private:
+        template <template <typename, typename> typename T, typename RuleT>
+        auto DifferentiateBinary(const T<Expression, Expression>& binary, RuleT rule) -> RetT
+        {
+            if (!binary.HasMostSigOp() || !binary.HasLeastSigOp()) {
+                return std::unexpected { "Missing operand." };
+            }
+
+            const auto mostSigOp = binary.GetMostSigOpPtr();
+            const auto leastSigOp = binary.GetLeastSigOpPtr();
+
+            auto mostSigOpDerivative = Differentiate(*mostSigOp);
+            if (!mostSigOpDerivative) {
+                return mostSigOpDerivative;
+            }
+
+            auto leastSigOpDerivative = Differentiate(*leastSigOp);
+            if (!leastSigOpDerivative) {
+                return leastSigOpDerivative;
+            }
+
+            if (!*mostSigOpDerivative && !*leastSigOpDerivative) {
+                return nullptr;
+            }
+
+            return rule(mostSigOp, std::move(mostSigOpDerivative).value(), leastSigOp, std::move(leastSigOpDerivative).value());
+        }
+
+        template <template <typename> typename T, typename RuleT>
+        auto DifferentiateUnary(const T<Expression>& unary, RuleT rule) -> RetT
+        {
+            if (!unary.HasOperand()) {
+                return std::unexpected { "Missing operand." };
+            }
+
+            const auto operand = unary.GetOperandPtr();
+
+            auto operandDerivative = Differentiate(*operand);
+            if (!operandDerivative || !*operandDerivative) {
+                return operandDerivative;
+            }
+
+            return rule(operand, std::move(operandDerivative).value());
+        }
+
+        std::string variable;
+        std::unordered_map<const Expression*, ExpressionPtr> memo;
+        std::vector<ExpressionPtr> innerDerivatives;
+    };
+
+} // namespace
+
+DifferentiateVisitor::DifferentiateVisitor(Variable variable)
+    : variable(std::move(variable))
+    , ownSimplifyVisitor(std::make_shared<SimplifyVisitor>())
+    , simplifyVisitor(ownSimplifyVisitor.get())
+{
+}
+
+DifferentiateVisitor::DifferentiateVisitor(Variable variable, SimplifyVisitor& simplifyVisitor)
+    : variable(std::move(variable))
+    , simplifyVisitor(&simplifyVisitor)
+{
+}
+
+auto DifferentiateVisitor::Differentiate(const Expression& expression) -> RetT
+{
+    const auto shared = EliminateCommonSubexpressions(expression);
+
+    DerivativeRules rules { variable.GetName() };
+    auto derivative = rules.Differentiate(*shared);
+    if (!derivative) {
+        return std::unexpected { derivative.error() };
+    }
+
+    if (!*derivative) {
+        return gsl_lite::not_null { std::make_unique<Real>(0.0) };
+    }
+
+    return simplifyVisitor->SimplifyShared(**derivative);
+}
+
+auto DifferentiateVisitor::TypedVisit(const Real& real) -> RetT { return Differentiate(real); }
+auto DifferentiateVisitor::TypedVisit(const Imaginary& imaginary) -> RetT { return Differentiate(imaginary); }
+auto DifferentiateVisitor::TypedVisit(const Variable& var) -> RetT { return Differentiate(var); }
+auto DifferentiateVisitor::TypedVisit(const Undefined& undefined) -> RetT { return Differentiate(undefined); }
+auto DifferentiateVisitor::TypedVisit(const Add<>& add) -> RetT { return Differentiate(add); }
+auto DifferentiateVisitor::TypedVisit(const Subtract<>& subtract) -> RetT { return Differentiate(subtract); }
+auto DifferentiateVisitor::TypedVisit(const Multiply<>& multiply) -> RetT { return Differentiate(multiply); }
+auto DifferentiateVisitor::TypedVisit(const Divide<>& divide) -> RetT { return Differentiate(divide); }
+auto DifferentiateVisitor::TypedVisit(const Exponent<>& exponent) -> RetT { return Differentiate(exponent); }
+auto DifferentiateVisitor::TypedVisit(const Log<>& log) -> RetT { return Differentiate(log); }
+auto DifferentiateVisitor::TypedVisit(const Negate<Expression>& negate) -> RetT { return Differentiate(negate); }
+auto DifferentiateVisitor::TypedVisit(const Sine<Expression>& sine) -> RetT { return Differentiate(sine); }
+auto DifferentiateVisitor::TypedVisit(const Derivative<>& derivative) -> RetT { return Differentiate(derivative); }
+auto DifferentiateVisitor::TypedVisit(const Integral<>& integral) -> RetT { return Differentiate(integral); }
+auto DifferentiateVisitor::TypedVisit(const Matrix& matrix) -> RetT { return Differentiate(matrix); }
+auto DifferentiateVisitor::TypedVisit(const EulerNumber& e) -> RetT { return Differentiate(e); }
+auto DifferentiateVisitor::TypedVisit(const Pi& pi) -> RetT { return Differentiate(pi); }
+auto DifferentiateVisitor::TypedVisit(const Magnitude<Expression>& magnitude) -> RetT { return Differentiate(magnitude); }
+
+} // Oasis
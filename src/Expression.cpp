@@ -1,6 +1,13 @@
+#include <array>
 #include <cmath>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <Oasis/Add.hpp>
+#include <Oasis/Compile.hpp>
 #include <Oasis/Divide.hpp>
 #include <Oasis/Exponent.hpp>
 #include <Oasis/Integral.hpp>
@@ -23,6 +30,49 @@ std::vector<long long> getAllFactors(long long n)
     return answer;
 }
 
+/**
+ * Removes the candidate roots p/q at which the polynomial is certainly not zero, by bounding it at
+ * all of them in one batch with interval arithmetic. Candidates whose bound contains zero are kept
+ * in order, as are all candidates if the polynomial cannot be compiled.
+ */
+void pruneRationalRoots(const Oasis::Expression& polynomial, const std::string& variableName,
+    std::vector<std::pair<long long, long long>>& candidates)
+{
+    const std::array variables { Oasis::Variable { variableName } };
+    const auto compiled = Oasis::Compile(polynomial, variables);
+    if (!compiled) {
+        return;
+    }
+
+    // Integers up to 2^53 convert exactly, so only the quotient is rounded, by at most half a unit
+    // in the last place.
+    constexpr long long EXACT = 1LL << 53;
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    std::vector<Oasis::Interval> roots;
+    roots.reserve(candidates.size());
+    for (auto [p, q] : candidates) {
+        if (std::abs(p) > EXACT || q > EXACT) {
+            roots.push_back({ -INF, INF });
+        } else {
+            const double root = static_cast<double>(p) / static_cast<double>(q);
+            roots.push_back({ std::nextafter(root, -INF), std::nextafter(root, INF) });
+        }
+    }
+
+    std::vector<Oasis::Interval> bounds(roots.size());
+    const std::array columns { std::span<const Oasis::Interval> { roots } };
+    compiled->EvaluateIntervalBatch(columns, bounds);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (bounds[i].Contains(0.0)) {
+            candidates[kept++] = candidates[i];
+        }
+    }
+    candidates.resize(kept);
+}
+
 long long gcf(long long a, long long b)
 {
     if (b > a) {
@@ -52,11 +102,12 @@ auto Expression::FindZeros() const -> std::vector<std::unique_ptr<Expression>>
     SimplifyVisitor simplifyVisitor {};
 
     std::vector<std::unique_ptr<Expression>> results;
-    std::vector<std::unique_ptr<Expression>> termsE;
-    if (auto addCase = RecursiveCast<Add<Expression>>(*this); addCase != nullptr) {
-        addCase->Flatten(termsE);
+    const std::unique_ptr<Expression> generalized = Generalize();
+    std::vector<const Expression*> termsE;
+    if (generalized->Is<Add>()) {
+        termsE = static_cast<const Add<Expression>&>(*generalized).FlattenView();
     } else {
-        termsE.push_back(Copy());
+        termsE.push_back(this);
     }
     std::string varName = "";
     std::vector<std::unique_ptr<Expression>> posCoefficents;
@@ -146,44 +197,45 @@ auto Expression::FindZeros() const -> std::vector<std::unique_ptr<Expression>>
     }
     if (termsC.size() == coefficents.size()) {
         std::reverse(termsC.begin(), termsC.end());
+        std::vector<std::pair<long long, long long>> candidates;
         for (auto pv : getAllFactors(termsC.back())) {
             for (auto qv : getAllFactors(termsC.front())) {
                 if (gcf(pv, qv) == 1) {
                     for (long long sign : { -1, 1 }) {
-                        bool doAdd = true;
-                        while (true) {
-                            long long mpv = pv * sign;
-                            std::vector<long long> newTermsC;
-                            long long h = 0;
-                            for (long long i : termsC) {
-                                h *= mpv;
-                                if (h % qv != 0) {
-                                    break;
-                                }
-                                h /= qv;
-                                h += i;
-                                newTermsC.push_back(h);
-                            }
-                            if (newTermsC.size() == termsC.size() && newTermsC.back() == 0) {
-                                termsC = newTermsC;
-                                if (doAdd) {
-                                    results.push_back(
-                                        std::make_unique<Divide<Real>>(Real(1.0 * mpv), Real(1.0 * qv)));
-                                    doAdd = false;
-                                }
-                                do {
-                                    termsC.pop_back();
-                                } while (termsC.back() == 0);
-                                if (termsC.size() <= 1) {
-                                    break;
-                                }
-                            } else {
-                                break;
-                            }
-                        }
+                        candidates.emplace_back(pv * sign, qv);
+                    }
+                }
+            }
+        }
+        pruneRationalRoots(*generalized, varName, candidates);
+        for (auto [mpv, qv] : candidates) {
+            bool doAdd = true;
+            while (true) {
+                std::vector<long long> newTermsC;
+                long long h = 0;
+                for (long long i : termsC) {
+                    h *= mpv;
+                    if (h % qv != 0) {
+                        break;
                     }
+                    h /= qv;
+                    h += i;
+                    newTermsC.push_back(h);
                 }
-                if (termsC.size() <= 1) {
+                if (newTermsC.size() == termsC.size() && newTermsC.back() == 0) {
+                    termsC = newTermsC;
+                    if (doAdd) {
+                        results.push_back(
+                            std::make_unique<Divide<Real>>(Real(1.0 * mpv), Real(1.0 * qv)));
+                        doAdd = false;
+                    }
+                    do {
+                        termsC.pop_back();
+                    } while (termsC.back() == 0);
+                    if (termsC.size() <= 1) {
+                        break;
+                    }
+                } else {
                     break;
                 }
             }
@@ -226,6 +278,11 @@ auto Expression::Differentiate(const Expression&) const -> std::unique_ptr<Expre
     return Copy();
 }
 
+auto Expression::GetOperandAt(std::size_t) const -> const Expression*
+{
+    return nullptr;
+}
+
 auto Expression::GetType() const -> ExpressionType
 {
     return ExpressionType::None;
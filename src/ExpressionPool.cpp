@@ -0,0 +1,242 @@
+//
+// Created by agent on 10/17/26.
+//
+
+#include <boost/container_hash/hash.hpp>
+
+#include "Oasis/ExpressionPool.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+auto ExpressionPool::KeyHash::operator()(const Key& key) const -> std::size_t
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, static_cast<int>(key.type));
+    boost::hash_combine(seed, key.operands[0]);
+    boost::hash_combine(seed, key.operands[1]);
+
+    // std::hash<double> maps 0.0 and -0.0 to the same bucket, matching Real::Equals
+    for (const double value : key.values) {
+        boost::hash_combine(seed, std::hash<double> {}(value));
+    }
+
+    boost::hash_combine(seed, key.name);
+    return seed;
+}
+
+auto ExpressionPool::Intern(const Expression& expression) -> std::shared_ptr<const Expression>
+{
+    auto interned = expression.Accept(*this);
+    visited.clear();
+    return interned ? std::move(interned).value() : nullptr;
+}
+
+auto ExpressionPool::Size() const -> std::size_t
+{
+    return nodes.size();
+}
+
+auto ExpressionPool::Clear() -> void
+{
+    nodes.clear();
+    visited.clear();
+}
+
+auto ExpressionPool::InternOperand(const std::shared_ptr<const Expression>& operand) -> RetT
+{
+    if (auto it = visited.find(operand.get()); it != visited.end()) {
+        return it->second.second;
+    }
+
+    auto interned = operand->Accept(*this);
+    if (!interned) {
+        return interned;
+    }
+
+    visited.emplace(operand.get(), std::pair { operand, *interned });
+    return interned;
+}
+
+template <template <typename, typename> typename T>
+auto ExpressionPool::InternBinary(const T<Expression, Expression>& binary) -> RetT
+{
+    std::shared_ptr<const Expression> mostSigOp, leastSigOp;
+
+    if (binary.HasMostSigOp()) {
+        auto interned = InternOperand(binary.GetMostSigOpPtr());
+        if (!interned) {
+            return interned;
+        }
+        mostSigOp = std::move(interned).value();
+    }
+
+    if (binary.HasLeastSigOp()) {
+        auto interned = InternOperand(binary.GetLeastSigOpPtr());
+        if (!interned) {
+            return interned;
+        }
+        leastSigOp = std::move(interned).value();
+    }
+
+    Key key { T<Expression, Expression>::GetStaticType(), { mostSigOp.get(), leastSigOp.get() } };
+    if (auto it = nodes.find(key); it != nodes.end()) {
+        return it->second;
+    }
+
+    auto node = std::make_shared<T<Expression, Expression>>();
+    node->SetMostSigOp(mostSigOp);
+    node->SetLeastSigOp(leastSigOp);
+
+    return nodes.emplace(std::move(key), std::move(node)).first->second;
+}
+
+template <template <typename> typename T>
+auto ExpressionPool::InternUnary(const T<Expression>& unary) -> RetT
+{
+    std::shared_ptr<const Expression> operand;
+
+    if (unary.HasOperand()) {
+        auto interned = InternOperand(unary.GetOperandPtr());
+        if (!interned) {
+            return interned;
+        }
+        operand = std::move(interned).value();
+    }
+
+    Key key { T<Expression>::GetStaticType(), { operand.get(), nullptr } };
+    if (auto it = nodes.find(key); it != nodes.end()) {
+        return it->second;
+    }
+
+    auto node = std::make_shared<T<Expression>>();
+    node->SetOperand(operand);
+
+    return nodes.emplace(std::move(key), std::move(node)).first->second;
+}
+
+template <typename T>
+auto ExpressionPool::InternLeaf(const T& leaf, Key key) -> RetT
+{
+    key.type = T::GetStaticType();
+    if (auto it = nodes.find(key); it != nodes.end()) {
+        return it->second;
+    }
+
+    return nodes.emplace(std::move(key), std::make_shared<const T>(leaf)).first->second;
+}
+
+auto ExpressionPool::TypedVisit(const Real& real) -> RetT
+{
+    return InternLeaf(real, Key { .values = { real.GetValue() } });
+}
+
+auto ExpressionPool::TypedVisit(const Imaginary& imaginary) -> RetT
+{
+    return InternLeaf(imaginary, Key {});
+}
+
+auto ExpressionPool::TypedVisit(const Variable& variable) -> RetT
+{
+    return InternLeaf(variable, Key { .name = variable.GetName() });
+}
+
+auto ExpressionPool::TypedVisit(const Undefined& undefined) -> RetT
+{
+    return InternLeaf(undefined, Key {});
+}
+
+auto ExpressionPool::TypedVisit(const Add<Expression, Expression>& add) -> RetT
+{
+    return InternBinary<Add>(add);
+}
+
+auto ExpressionPool::TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT
+{
+    return InternBinary<Subtract>(subtract);
+}
+
+auto ExpressionPool::TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT
+{
+    return InternBinary<Multiply>(multiply);
+}
+
+auto ExpressionPool::TypedVisit(const Divide<Expression, Expression>& divide) -> RetT
+{
+    return InternBinary<Divide>(divide);
+}
+
+auto ExpressionPool::TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT
+{
+    return InternBinary<Exponent>(exponent);
+}
+
+auto ExpressionPool::TypedVisit(const Log<Expression, Expression>& log) -> RetT
+{
+    return InternBinary<Log>(log);
+}
+
+auto ExpressionPool::TypedVisit(const Negate<Expression>& negate) -> RetT
+{
+    return InternUnary<Negate>(negate);
+}
+
+auto ExpressionPool::TypedVisit(const Sine<Expression>& sine) -> RetT
+{
+    return InternUnary<Sine>(sine);
+}
+
+auto ExpressionPool::TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT
+{
+    return InternBinary<Derivative>(derivative);
+}
+
+auto ExpressionPool::TypedVisit(const Integral<Expression, Expression>& integral) -> RetT
+{
+    return InternBinary<Integral>(integral);
+}
+
+auto ExpressionPool::TypedVisit(const Matrix& matrix) -> RetT
+{
+    const MatrixXXD& data = matrix.GetMatrix();
+
+    Key key { .values = { static_cast<double>(data.rows()), static_cast<double>(data.cols()) } };
+    key.values.insert(key.values.end(), data.data(), data.data() + data.size());
+
+    return InternLeaf(matrix, std::move(key));
+}
+
+auto ExpressionPool::TypedVisit(const EulerNumber& e) -> RetT
+{
+    return InternLeaf(e, Key {});
+}
+
+auto ExpressionPool::TypedVisit(const Pi& pi) -> RetT
+{
+    return InternLeaf(pi, Key {});
+}
+
+auto ExpressionPool::TypedVisit(const Magnitude<Expression>& magnitude) -> RetT
+{
+    return InternUnary<Magnitude>(magnitude);
+}
+
+} // Oasis
@@ -0,0 +1,359 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Oasis/FiniteSum.hpp"
+
+#include "Oasis/Real.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    // The number of terms evaluated together by EvaluateBatch.
+    constexpr std::size_t BATCH_SIZE = 1024;
+
+    // Ranges are split into at most MAX_BLOCKS blocks of at least MIN_BLOCK_SIZE terms, so that a
+    // block is worth handing to a thread and the sums of the blocks fit in memory.
+    constexpr std::uint64_t MIN_BLOCK_SIZE = 1 << 16;
+    constexpr std::uint64_t MAX_BLOCKS = 1 << 12;
+
+    // Beyond this degree, the terms of Faulhaber's formula cancel too much to be accurate.
+    constexpr std::size_t MAX_CLOSED_FORM_DEGREE = 16;
+
+    /**
+     * A running sum that carries the rounding error of each addition separately, following
+     * Neumaier's improvement of Kahan summation, which also holds when a term is larger than the
+     * sum so far.
+     */
+    class NeumaierSum {
+    public:
+        auto Add(double term) -> void
+        {
+            const double total = sum + term;
+            compensation += std::abs(sum) >= std::abs(term) ? (sum - total) + term : (term - total) + sum;
+            sum = total;
+        }
+
+        [[nodiscard]] auto Value() const -> double
+        {
+            return sum + compensation;
+        }
+
+    private:
+        double sum = 0.0;
+        double compensation = 0.0;
+    };
+
+    auto SumBlock(const CompiledExpression& summand, std::int64_t first, std::uint64_t count) -> double
+    {
+        std::array<double, BATCH_SIZE> indices {};
+        std::array<double, BATCH_SIZE> terms {};
+        NeumaierSum sum;
+
+        for (std::uint64_t done = 0; done < count; done += BATCH_SIZE) {
+            const std::size_t size = std::min<std::uint64_t>(BATCH_SIZE, count - done);
+            for (std::size_t i = 0; i < size; ++i) {
+                indices[i] = static_cast<double>(first + static_cast<std::int64_t>(done + i));
+            }
+
+            const std::array columns { std::span<const double> { indices.data(), size } };
+            summand.EvaluateBatch(columns, std::span { terms.data(), size });
+
+            for (std::size_t i = 0; i < size; ++i) {
+                sum.Add(terms[i]);
+            }
+        }
+
+        return sum.Value();
+    }
+
+    // Coefficients of a polynomial, constant term first.
+    using Polynomial = std::vector<double>;
+
+    auto Product(const Polynomial& lhs, const Polynomial& rhs) -> std::optional<Polynomial>
+    {
+        if (lhs.size() + rhs.size() - 2 > MAX_CLOSED_FORM_DEGREE) {
+            return std::nullopt;
+        }
+
+        Polynomial product(lhs.size() + rhs.size() - 1);
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            for (std::size_t j = 0; j < rhs.size(); ++j) {
+                product[i + j] += lhs[i] * rhs[j];
+            }
+        }
+
+        return product;
+    }
+
+    /**
+     * Finds the coefficients of an expression as a polynomial in `index`, if it is one with numeric
+     * coefficients.
+     */
+    auto PolynomialIn(const Expression& expression, const std::string& index) -> std::optional<Polynomial>
+    {
+        const auto operand = [&expression, &index](std::size_t i) {
+            return PolynomialIn(*expression.GetOperandAt(i), index);
+        };
+
+        switch (expression.GetType()) {
+        case ExpressionType::Variable:
+            if (static_cast<const Variable&>(expression).GetName() == index) {
+                return Polynomial { 0.0, 1.0 };
+            }
+            return std::nullopt;
+        case ExpressionType::Add:
+        case ExpressionType::Subtract: {
+            auto lhs = operand(0);
+            auto rhs = lhs ? operand(1) : std::nullopt;
+            if (!rhs) {
+                return std::nullopt;
+            }
+
+            const double sign = expression.Is<Subtract>() ? -1.0 : 1.0;
+            lhs->resize(std::max(lhs->size(), rhs->size()));
+            for (std::size_t i = 0; i < rhs->size(); ++i) {
+                (*lhs)[i] += sign * (*rhs)[i];
+            }
+            return lhs;
+        }
+        case ExpressionType::Multiply: {
+            auto lhs = operand(0);
+            auto rhs = lhs ? operand(1) : std::nullopt;
+            return rhs ? Product(*lhs, *rhs) : std::nullopt;
+        }
+        case ExpressionType::Divide: {
+            auto dividend = operand(0);
+            auto divisor = dividend ? operand(1) : std::nullopt;
+            if (!divisor || divisor->size() != 1 || (*divisor)[0] == 0.0) {
+                return std::nullopt;
+            }
+
+            for (double& coefficient : *dividend) {
+                coefficient /= (*divisor)[0];
+            }
+            return dividend;
+        }
+        case ExpressionType::Negate: {
+            auto negated = operand(0);
+            if (negated) {
+                std::ranges::transform(*negated, negated->begin(), std::negate {});
+            }
+            return negated;
+        }
+        case ExpressionType::Exponent: {
+            auto base = operand(0);
+            auto power = base ? operand(1) : std::nullopt;
+            if (!power || power->size() != 1) {
+                return std::nullopt;
+            }
+
+            const double exponent = (*power)[0];
+            if (base->size() == 1) {
+                return Polynomial { std::pow((*base)[0], exponent) };
+            }
+
+            if (exponent < 0.0 || exponent != std::floor(exponent) || exponent > MAX_CLOSED_FORM_DEGREE) {
+                return std::nullopt;
+            }
+
+            std::optional<Polynomial> result = Polynomial { 1.0 };
+            for (int i = 0; result && i < static_cast<int>(exponent); ++i) {
+                result = Product(*result, *base);
+            }
+            return result;
+        }
+        default: {
+            // Any other expression is a polynomial only if it is a constant.
+            const auto constant = Compile(expression, {});
+            if (!constant) {
+                return std::nullopt;
+            }
+            return Polynomial { (*constant)(std::span<const double> {}) };
+        }
+        }
+    }
+
+    auto Binomials() -> const std::array<std::array<double, MAX_CLOSED_FORM_DEGREE + 2>, MAX_CLOSED_FORM_DEGREE + 2>&
+    {
+        static const auto binomials = [] {
+            std::array<std::array<double, MAX_CLOSED_FORM_DEGREE + 2>, MAX_CLOSED_FORM_DEGREE + 2> table {};
+            for (std::size_t n = 0; n < table.size(); ++n) {
+                table[n][0] = 1.0;
+                for (std::size_t k = 1; k <= n; ++k) {
+                    table[n][k] = table[n - 1][k - 1] + table[n - 1][k];
+                }
+            }
+            return table;
+        }();
+        return binomials;
+    }
+
+    // The Bernoulli numbers, with B_1 = -1/2.
+    auto BernoulliNumbers() -> const std::array<double, MAX_CLOSED_FORM_DEGREE + 1>&
+    {
+        static const auto bernoulli = [] {
+            const auto& binomials = Binomials();
+            std::array<double, MAX_CLOSED_FORM_DEGREE + 1> numbers { 1.0 };
+            for (std::size_t m = 1; m < numbers.size(); ++m) {
+                double sum = 0.0;
+                for (std::size_t k = 0; k < m; ++k) {
+                    sum += binomials[m + 1][k] * numbers[k];
+                }
+                numbers[m] = -sum / static_cast<double>(m + 1);
+            }
+            return numbers;
+        }();
+        return bernoulli;
+    }
+
+    /**
+     * Computes the sum of m^p for m from 0 to n - 1 with Faulhaber's formula,
+     * (1 / (p + 1)) Σ_{j=0}^{p} C(p + 1, j) B_j n^(p + 1 - j).
+     */
+    auto PowerSum(std::size_t p, double n) -> double
+    {
+        const auto& binomials = Binomials();
+        const auto& bernoulli = BernoulliNumbers();
+
+        // Horner's rule in n, from the leading term down to the linear one
+        double sum = 0.0;
+        for (std::size_t j = 0; j <= p; ++j) {
+            sum = sum * n + binomials[p + 1][j] * bernoulli[j];
+        }
+
+        return sum * n / static_cast<double>(p + 1);
+    }
+
+    /**
+     * Sums a polynomial over the integers from `lower` to `upper`. The polynomial is shifted to
+     * start at zero first, so that its sum over a range far from zero does not come from the
+     * difference of two much larger sums.
+     */
+    auto ClosedForm(const Polynomial& polynomial, std::int64_t lower, std::int64_t upper) -> double
+    {
+        const auto& binomials = Binomials();
+        const double start = static_cast<double>(lower);
+        const double count = static_cast<double>(upper - lower) + 1.0;
+
+        NeumaierSum sum;
+        for (std::size_t i = 0; i < polynomial.size(); ++i) {
+            // The coefficient of m^i in p(lower + m)
+            double shifted = 0.0;
+            for (std::size_t j = polynomial.size(); j-- > i;) {
+                shifted = shifted * start + polynomial[j] * binomials[j][i];
+            }
+
+            sum.Add(shifted * PowerSum(i, count));
+        }
+
+        return sum.Value();
+    }
+
+    auto IntegerBound(const Expression& bound, SimplifyVisitor& simplifyVisitor) -> std::expected<std::int64_t, std::string>
+    {
+        auto simplified = bound.Accept(simplifyVisitor);
+        if (!simplified) {
+            return std::unexpected { simplified.error() };
+        }
+
+        if (!(*simplified)->Is<Real>()) {
+            return std::unexpected { "The bounds of summation must be numbers." };
+        }
+
+        // Integers beyond 2^53 are not all representable as doubles.
+        const double value = static_cast<const Real&>(**simplified).GetValue();
+        if (value != std::trunc(value) || std::abs(value) > 0x1p53) {
+            return std::unexpected { "The bounds of summation must be integers." };
+        }
+
+        return static_cast<std::int64_t>(value);
+    }
+
+} // namespace
+
+auto CompensatedSum(const CompiledExpression& summand, std::int64_t lower, std::int64_t upper, const SummationOpts& opts) -> double
+{
+    if (summand.GetVariableCount() > 1) {
+        throw std::invalid_argument("The summand must have at most one variable.");
+    }
+
+    if (upper < lower) {
+        return 0.0;
+    }
+
+    const auto count = static_cast<std::uint64_t>(upper - lower) + 1;
+    const auto blockSize = std::max(MIN_BLOCK_SIZE, (count + MAX_BLOCKS - 1) / MAX_BLOCKS);
+    const auto blocks = (count + blockSize - 1) / blockSize;
+
+    std::vector<double> blockSums(blocks);
+    std::atomic<std::uint64_t> nextBlock = 0;
+
+    const auto sumBlocks = [&] {
+        for (auto block = nextBlock++; block < blocks; block = nextBlock++) {
+            const auto first = lower + static_cast<std::int64_t>(block * blockSize);
+            blockSums[block] = SumBlock(summand, first, std::min(blockSize, count - block * blockSize));
+        }
+    };
+
+    const std::size_t threads = opts.threads != 0 ? opts.threads : std::max(1U, std::thread::hardware_concurrency());
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 1; i < std::min<std::uint64_t>(threads, blocks); ++i) {
+            workers.emplace_back(sumBlocks);
+        }
+
+        sumBlocks();
+    }
+
+    NeumaierSum sum;
+    for (const double blockSum : blockSums) {
+        sum.Add(blockSum);
+    }
+
+    return sum.Value();
+}
+
+auto EvaluateSummation(const Expression& summand, const Variable& index, const Expression& lower, const Expression& upper, const SummationOpts& opts) -> std::expected<double, std::string>
+{
+    SimplifyVisitor simplifyVisitor {};
+
+    const auto first = IntegerBound(lower, simplifyVisitor);
+    if (!first) {
+        return std::unexpected { first.error() };
+    }
+
+    const auto last = IntegerBound(upper, simplifyVisitor);
+    if (!last) {
+        return std::unexpected { last.error() };
+    }
+
+    if (*last < *first) {
+        return 0.0;
+    }
+
+    if (const auto polynomial = PolynomialIn(summand, index.GetName())) {
+        return ClosedForm(*polynomial, *first, *last);
+    }
+
+    const std::array variables { index };
+    return Compile(summand, variables).transform([&](const CompiledExpression& compiled) {
+        return CompensatedSum(compiled, *first, *last, opts);
+    });
+}
+
+} // Oasis
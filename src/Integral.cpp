@@ -5,6 +5,8 @@
 #include "Oasis/Integral.hpp"
 
 #include "Oasis/Add.hpp"
+#include "Oasis/Quadrature.hpp"
+#include "Oasis/Variable.hpp"
 // #include "Oasis/Log.hpp"
 // #include "Oasis/Imaginary.hpp"
 
@@ -23,6 +25,14 @@ auto Integral<Expression>::Simplify(const Expression& upper, const Expression& l
     std::unique_ptr<Expression> simplifiedIntegrand = mostSigOp ? mostSigOp->Accept(simplifyVisitor).value() : std::unique_ptr<Expression> { nullptr };
     std::unique_ptr<Expression> simplifiedDifferential = leastSigOp ? leastSigOp->Accept(simplifyVisitor).value() : std::unique_ptr<Expression> { nullptr };
 
+    // Definite integrals with numeric bounds are evaluated, numerically if need be, unless the
+    // numeric integration does not converge.
+    if (simplifiedDifferential->Is<Variable>()) {
+        if (auto result = EvaluateDefiniteIntegral(*simplifiedIntegrand, static_cast<const Variable&>(*simplifiedDifferential), lower, upper); result && result->converged) {
+            return std::make_unique<Real>(result->value);
+        }
+    }
+
     return simplifiedIntegrand->IntegrateWithBounds(*simplifiedDifferential, upper, lower);
     /*
         Integral simplifiedIntegrate { *simplifiedIntegrand, *simplifiedDifferential };
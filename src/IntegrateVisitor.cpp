@@ -0,0 +1,491 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Oasis/IntegrateVisitor.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/DifferentiateVisitor.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Hash.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    /**
+     * Applies the rules of integration to simplified integrands, without adding a constant of
+     * integration. A rule that does not apply returns nullptr, as does every rule once the budget
+     * is spent.
+     */
+    class IntegrationRules final {
+    public:
+        IntegrationRules(const Variable& variable, SimplifyVisitor& simplifyVisitor, const IntegrateOpts& options, ExpressionCache<std::shared_ptr<const Expression>>& memo)
+            : variable(variable)
+            , simplifyVisitor(simplifyVisitor)
+            , options(options)
+            , memo(memo)
+            , remainingRules(options.ruleBudget)
+        {
+        }
+
+        auto Antiderivative(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            if (const auto* known = memo.Find(integrand)) {
+                return (*known)->Copy();
+            }
+
+            if (remainingRules == 0) {
+                return nullptr;
+            }
+
+            // Integrating by parts can lead back to an integrand that is still being integrated,
+            // which no rule will get any closer to integrating.
+            if (std::ranges::any_of(pending, [&integrand](const Expression* other) { return ExpressionIdentical {}(*other, integrand); })) {
+                return nullptr;
+            }
+
+            --remainingRules;
+            pending.push_back(&integrand);
+            auto antiderivative = Apply(integrand);
+            pending.pop_back();
+
+            if (antiderivative) {
+                memo.Insert(integrand, std::shared_ptr<const Expression> { antiderivative->Copy() });
+            }
+
+            return antiderivative;
+        }
+
+    private:
+        using Rule = auto (IntegrationRules::*)(const Expression&) -> std::unique_ptr<Expression>;
+
+        static auto RulesFor(ExpressionType type) -> const std::vector<Rule>&
+        {
+            // Rules are tried in order, and only for the type of the outermost expression of an
+            // integrand that depends on the variable.
+            static const std::unordered_map<ExpressionType, std::vector<Rule>> rules {
+                { ExpressionType::Variable, { &IntegrationRules::Identity } },
+                { ExpressionType::Add, { &IntegrationRules::Sum } },
+                { ExpressionType::Subtract, { &IntegrationRules::Difference } },
+                { ExpressionType::Negate, { &IntegrationRules::Negation } },
+                { ExpressionType::Multiply, { &IntegrationRules::ConstantFactor, &IntegrationRules::ByParts } },
+                { ExpressionType::Divide, { &IntegrationRules::ConstantDivisor } },
+                { ExpressionType::Exponent, { &IntegrationRules::Power, &IntegrationRules::Exponential } },
+                { ExpressionType::Log, { &IntegrationRules::Logarithm } },
+            };
+            static const std::vector<Rule> none;
+
+            const auto it = rules.find(type);
+            return it == rules.end() ? none : it->second;
+        }
+
+        auto Apply(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            if (!DependsOnVariable(integrand)) {
+                return Constant(integrand);
+            }
+
+            for (const Rule rule : RulesFor(integrand.GetType())) {
+                if (auto antiderivative = (this->*rule)(integrand)) {
+                    return antiderivative;
+                }
+            }
+
+            return nullptr;
+        }
+
+        [[nodiscard]] auto DependsOnVariable(const Expression& expression) const -> bool
+        {
+            if (expression.Is<Variable>()) {
+                return static_cast<const Variable&>(expression).GetName() == variable.GetName();
+            }
+
+            for (std::size_t i = 0; const Expression* op = expression.GetOperandAt(i); ++i) {
+                if (DependsOnVariable(*op)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        auto Simplify(const Expression& expression) -> std::unique_ptr<Expression>
+        {
+            auto simplified = expression.Accept(simplifyVisitor);
+            if (!simplified) {
+                return nullptr;
+            }
+
+            return std::move(simplified).value();
+        }
+
+        auto Differentiate(const Expression& expression) -> std::unique_ptr<Expression>
+        {
+            DifferentiateVisitor differentiateVisitor { variable, simplifyVisitor };
+            auto derivative = expression.Accept(differentiateVisitor);
+            if (!derivative) {
+                return nullptr;
+            }
+
+            return std::move(derivative).value();
+        }
+
+        // The slope of an expression that is linear in the variable.
+        auto LinearCoefficient(const Expression& expression) -> std::optional<double>
+        {
+            const auto derivative = Differentiate(expression);
+            if (!derivative || !derivative->Is<Real>()) {
+                return std::nullopt;
+            }
+
+            const double slope = static_cast<const Real&>(*derivative).GetValue();
+            return slope == 0.0 ? std::nullopt : std::optional { slope };
+        }
+
+        // ∫c dx = cx
+        auto Constant(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            if (integrand.Is<Undefined>() || integrand.Is<Matrix>()) {
+                return nullptr;
+            }
+
+            if (integrand.Is<Real>() && static_cast<const Real&>(integrand).GetValue() == 0.0) {
+                return std::make_unique<Real>(0.0);
+            }
+
+            return std::make_unique<Multiply<>>(integrand, variable);
+        }
+
+        // ∫x dx = x^2 / 2
+        auto Identity(const Expression&) -> std::unique_ptr<Expression>
+        {
+            return std::make_unique<Divide<>>(Exponent<> { variable, Real { 2.0 } }, Real { 2.0 });
+        }
+
+        // ∫x^n dx = x^(n + 1) / (n + 1) for n ≠ -1
+        auto Power(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            const Expression& base = *integrand.GetOperandAt(0);
+            const Expression& power = *integrand.GetOperandAt(1);
+
+            if (!base.Equals(variable) || !power.Is<Real>()) {
+                return nullptr;
+            }
+
+            const double raised = static_cast<const Real&>(power).GetValue() + 1.0;
+            if (raised == 0.0) {
+                return nullptr;
+            }
+
+            return std::make_unique<Divide<>>(Exponent<> { variable, Real { raised } }, Real { raised });
+        }
+
+        // ∫b^(ax + c) dx = b^(ax + c) / (a ln(b))
+        auto Exponential(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            const Expression& base = *integrand.GetOperandAt(0);
+            if (DependsOnVariable(base)) {
+                return nullptr;
+            }
+
+            const auto slope = LinearCoefficient(*integrand.GetOperandAt(1));
+            if (!slope) {
+                return nullptr;
+            }
+
+            if (base.Is<EulerNumber>()) {
+                return *slope == 1.0 ? integrand.Copy() : std::make_unique<Divide<>>(integrand, Real { *slope });
+            }
+
+            const Log<> lnBase { EulerNumber {}, base };
+            if (*slope == 1.0) {
+                return std::make_unique<Divide<>>(integrand, lnBase);
+            }
+
+            return std::make_unique<Divide<>>(integrand, Multiply<> { Real { *slope }, lnBase });
+        }
+
+        // ∫log_b(ax + c) dx = (ax + c)(ln(ax + c) - 1) / (a ln(b))
+        auto Logarithm(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            const Expression& base = *integrand.GetOperandAt(0);
+            const Expression& argument = *integrand.GetOperandAt(1);
+            if (DependsOnVariable(base)) {
+                return nullptr;
+            }
+
+            const auto slope = LinearCoefficient(argument);
+            if (!slope) {
+                return nullptr;
+            }
+
+            std::unique_ptr<Expression> antiderivative = std::make_unique<Multiply<>>(argument, Subtract<> { Log<> { EulerNumber {}, argument }, Real { 1.0 } });
+            if (*slope != 1.0) {
+                antiderivative = std::make_unique<Divide<>>(*antiderivative, Real { *slope });
+            }
+
+            if (!base.Is<EulerNumber>()) {
+                antiderivative = std::make_unique<Divide<>>(*antiderivative, Log<> { EulerNumber {}, base });
+            }
+
+            return antiderivative;
+        }
+
+        // ∫(f + g) dx = ∫f dx + ∫g dx
+        auto Sum(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            auto augend = Antiderivative(*integrand.GetOperandAt(0));
+            auto addend = augend ? Antiderivative(*integrand.GetOperandAt(1)) : nullptr;
+            return addend ? std::make_unique<Add<>>(*augend, *addend) : nullptr;
+        }
+
+        // ∫(f - g) dx = ∫f dx - ∫g dx
+        auto Difference(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            auto minuend = Antiderivative(*integrand.GetOperandAt(0));
+            auto subtrahend = minuend ? Antiderivative(*integrand.GetOperandAt(1)) : nullptr;
+            return subtrahend ? std::make_unique<Subtract<>>(*minuend, *subtrahend) : nullptr;
+        }
+
+        // ∫-f dx = -∫f dx
+        auto Negation(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            auto operand = Antiderivative(*integrand.GetOperandAt(0));
+            return operand ? std::make_unique<Negate<Expression>>(*operand) : nullptr;
+        }
+
+        // ∫cf dx = c∫f dx, where c is the product of every constant factor
+        auto ConstantFactor(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            std::vector<const Expression*> constants;
+            std::vector<const Expression*> factors;
+            for (const Expression* factor : Factors(integrand)) {
+                (DependsOnVariable(*factor) ? factors : constants).push_back(factor);
+            }
+
+            if (constants.empty()) {
+                return nullptr;
+            }
+
+            auto antiderivative = Antiderivative(*Product(factors));
+            return antiderivative ? std::make_unique<Multiply<>>(*Product(constants), *antiderivative) : nullptr;
+        }
+
+        // ∫f/c dx = (∫f dx) / c
+        auto ConstantDivisor(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            const Expression& divisor = *integrand.GetOperandAt(1);
+            if (DependsOnVariable(divisor)) {
+                return nullptr;
+            }
+
+            auto antiderivative = Antiderivative(*integrand.GetOperandAt(0));
+            return antiderivative ? std::make_unique<Divide<>>(*antiderivative, divisor) : nullptr;
+        }
+
+        // The factors of a product, however its multiplications are nested.
+        static auto Factors(const Expression& product) -> std::vector<const Expression*>
+        {
+            std::vector<const Expression*> factors;
+            std::vector<const Expression*> pendingProducts { &product };
+
+            while (!pendingProducts.empty()) {
+                const Expression* expression = pendingProducts.back();
+                pendingProducts.pop_back();
+
+                if (expression->Is<Multiply>()) {
+                    pendingProducts.push_back(expression->GetOperandAt(1));
+                    pendingProducts.push_back(expression->GetOperandAt(0));
+                } else {
+                    factors.push_back(expression);
+                }
+            }
+
+            return factors;
+        }
+
+        static auto Product(const std::vector<const Expression*>& factors) -> std::unique_ptr<Expression>
+        {
+            auto product = factors.front()->Copy();
+            for (auto it = std::next(factors.begin()); it != factors.end(); ++it) {
+                product = std::make_unique<Multiply<>>(*product, **it);
+            }
+
+            return product;
+        }
+
+        // LIPET: logarithms are differentiated first and exponentials last.
+        [[nodiscard]] auto PartsPriority(const Expression& factor) const -> int
+        {
+            switch (factor.GetType()) {
+            case ExpressionType::Log:
+                return 0;
+            case ExpressionType::Sine:
+                return 3;
+            case ExpressionType::Exponent:
+                return DependsOnVariable(*factor.GetOperandAt(0)) ? 2 : 4;
+            default:
+                return 2;
+            }
+        }
+
+        // ∫u dv = uv - ∫v du, where dv is the factor integrated most easily
+        auto ByParts(const Expression& integrand) -> std::unique_ptr<Expression>
+        {
+            if (partsDepth == options.partsDepth) {
+                return nullptr;
+            }
+
+            auto factors = Factors(integrand);
+            const auto dvFactor = std::ranges::max_element(factors, {}, [this](const Expression* factor) { return PartsPriority(*factor); });
+            const Expression& dv = **dvFactor;
+            factors.erase(dvFactor);
+            const auto u = Product(factors);
+
+            auto v = Antiderivative(dv);
+            if (!v) {
+                return nullptr;
+            }
+
+            auto du = Differentiate(*u);
+            if (!du) {
+                return nullptr;
+            }
+
+            // Constant factors are kept out of v du, so that only the factors that depend on the
+            // variable are simplified together.
+            std::vector<const Expression*> constants;
+            std::vector<const Expression*> vduFactors;
+            for (const Expression* product : { v.get(), du.get() }) {
+                for (const Expression* factor : Factors(*product)) {
+                    (DependsOnVariable(*factor) ? vduFactors : constants).push_back(factor);
+                }
+            }
+
+            auto vdu = vduFactors.empty() ? Simplify(Multiply<> { *v, *du }) : Simplify(*Product(vduFactors));
+            if (!vdu) {
+                return nullptr;
+            }
+
+            ++partsDepth;
+            auto integratedVdu = Antiderivative(*vdu);
+            --partsDepth;
+
+            if (!integratedVdu) {
+                return nullptr;
+            }
+
+            if (!vduFactors.empty() && !constants.empty()) {
+                integratedVdu = std::make_unique<Multiply<>>(*Product(constants), *integratedVdu);
+            }
+
+            return std::make_unique<Subtract<>>(Multiply<> { *u, *v }, *integratedVdu);
+        }
+
+        const Variable& variable;
+        SimplifyVisitor& simplifyVisitor;
+        const IntegrateOpts& options;
+        ExpressionCache<std::shared_ptr<const Expression>>& memo;
+
+        std::size_t remainingRules;
+        std::size_t partsDepth = 0;
+
+        // The integrands being integrated, outermost first.
+        std::vector<const Expression*> pending;
+    };
+
+} // namespace
+
+IntegrateVisitor::IntegrateVisitor(Variable variable, IntegrateOpts opts)
+    : variable(std::move(variable))
+    , options(opts)
+    , ownSimplifyVisitor(std::make_shared<SimplifyVisitor>())
+    , simplifyVisitor(ownSimplifyVisitor.get())
+    , memo(std::make_shared<ExpressionCache<std::shared_ptr<const Expression>>>(opts.memoCapacity))
+{
+}
+
+IntegrateVisitor::IntegrateVisitor(Variable variable, SimplifyVisitor& simplifyVisitor, IntegrateOpts opts)
+    : variable(std::move(variable))
+    , options(opts)
+    , simplifyVisitor(&simplifyVisitor)
+    , memo(std::make_shared<ExpressionCache<std::shared_ptr<const Expression>>>(opts.memoCapacity))
+{
+}
+
+auto IntegrateVisitor::GetMemoSize() const -> std::size_t
+{
+    return memo->Size();
+}
+
+auto IntegrateVisitor::Antiderivative(const Expression& integrand) -> std::unique_ptr<Expression>
+{
+    auto simplified = integrand.Accept(*simplifyVisitor);
+    if (!simplified) {
+        return nullptr;
+    }
+
+    IntegrationRules rules { variable, *simplifyVisitor, options, *memo };
+    return rules.Antiderivative(**simplified);
+}
+
+auto IntegrateVisitor::Integrate(const Expression& integrand) -> RetT
+{
+    auto simplified = integrand.Accept(*simplifyVisitor);
+    if (!simplified) {
+        return simplified;
+    }
+
+    const auto& simplifiedIntegrand = **simplified;
+
+    IntegrationRules rules { variable, *simplifyVisitor, options, *memo };
+    const auto antiderivative = rules.Antiderivative(simplifiedIntegrand);
+    if (!antiderivative) {
+        return gsl_lite::not_null { std::make_unique<Integral<>>(simplifiedIntegrand, variable) };
+    }
+
+    return Add<> { *antiderivative, Variable { "C" } }.Accept(*simplifyVisitor);
+}
+
+auto IntegrateVisitor::TypedVisit(const Real& real) -> RetT { return Integrate(real); }
+auto IntegrateVisitor::TypedVisit(const Imaginary& imaginary) -> RetT { return Integrate(imaginary); }
+auto IntegrateVisitor::TypedVisit(const Variable& var) -> RetT { return Integrate(var); }
+auto IntegrateVisitor::TypedVisit(const Undefined& undefined) -> RetT { return Integrate(undefined); }
+auto IntegrateVisitor::TypedVisit(const Add<>& add) -> RetT { return Integrate(add); }
+auto IntegrateVisitor::TypedVisit(const Subtract<>& subtract) -> RetT { return Integrate(subtract); }
+auto IntegrateVisitor::TypedVisit(const Multiply<>& multiply) -> RetT { return Integrate(multiply); }
+auto IntegrateVisitor::TypedVisit(const Divide<>& divide) -> RetT { return Integrate(divide); }
+auto IntegrateVisitor::TypedVisit(const Exponent<>& exponent) -> RetT { return Integrate(exponent); }
+auto IntegrateVisitor::TypedVisit(const Log<>& log) -> RetT { return Integrate(log); }
+auto IntegrateVisitor::TypedVisit(const Negate<Expression>& negate) -> RetT { return Integrate(negate); }
+auto IntegrateVisitor::TypedVisit(const Sine<Expression>& sine) -> RetT { return Integrate(sine); }
+auto IntegrateVisitor::TypedVisit(const Derivative<>& derivative) -> RetT { return Integrate(derivative); }
+auto IntegrateVisitor::TypedVisit(const Integral<>& integral) -> RetT { return Integrate(integral); }
+auto IntegrateVisitor::TypedVisit(const Matrix& matrix) -> RetT { return Integrate(matrix); }
+auto IntegrateVisitor::TypedVisit(const EulerNumber& e) -> RetT { return Integrate(e); }
+auto IntegrateVisitor::TypedVisit(const Pi& pi) -> RetT { return Integrate(pi); }
+auto IntegrateVisitor::TypedVisit(const Magnitude<Expression>& magnitude) -> RetT { return Integrate(magnitude); }
+
+} // Oasis
@@ -59,10 +59,12 @@ auto ConstructMatrices(const std::vector<std::unique_ptr<Expression>>& exprs)
     size_t varCount = 0;
     std::map<std::string, Eigen::Index> vars; // variable name, column in matrix
     for (size_t row = 0; row < exprs.size(); row++) {
-        std::vector<std::unique_ptr<Expression>> terms;
-        auto expr = RecursiveCast<Add<Expression>>(*exprs[row]);
-        expr->Flatten(terms);
-        for (auto& term : terms) {
+        const std::unique_ptr<Expression> expr = exprs[row]->Generalize();
+        std::vector<const Expression*> terms { expr.get() };
+        if (expr->Is<Add>()) {
+            terms = static_cast<const Add<Expression>&>(*expr).FlattenView();
+        }
+        for (const Expression* term : terms) {
             if (auto r = RecursiveCast<Real>(*term); r != nullptr) { // real number
                 b[Eigen::Index(row)] = -1 * r->GetValue();
             } else if (auto v = RecursiveCast<Variable>(*term); v != nullptr) { // variable by itself (coefficient of 1)
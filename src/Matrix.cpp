@@ -44,6 +44,17 @@ auto Matrix::Equals(const Expression& other) const -> bool
         && matrix == dynamic_cast<const Matrix&>(other).matrix;
 }
 
+auto Matrix::Hash() const -> std::size_t
+{
+    std::size_t hash = HashCombine(HashType(ExpressionType::Matrix), matrix.rows());
+    hash = HashCombine(hash, matrix.cols());
+    for (Eigen::Index i = 0; i < matrix.size(); i++) {
+        const double value = matrix.data()[i];
+        hash = HashCombine(hash, std::hash<double> {}(value == 0.0 ? 0.0 : value));
+    }
+    return hash;
+}
+
 auto Matrix::GetMatrix() const -> MatrixXXD
 {
     return matrix;
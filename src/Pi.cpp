@@ -10,7 +10,7 @@ namespace Oasis {
 
 auto Pi::Equals(const Expression& other) const -> bool
 {
-    return other.Is<Pi>() == dynamic_cast<const Pi&>(other).Is<Pi>();
+    return other.Is<Pi>();
 }
 
 auto Pi::GetValue() -> double
@@ -0,0 +1,285 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Oasis/Quadrature.hpp"
+
+#include "Oasis/IntegrateVisitor.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    // The nonnegative nodes of the 15 point Kronrod rule on [-1, 1], outermost first. The nodes at
+    // odd indices and the center are the nodes of the 7 point Gauss rule.
+    constexpr std::array KRONROD_NODES {
+        0.991455371120812639206854697526329,
+        0.949107912342758524526189684047851,
+        0.864864423359769072789712788640926,
+        0.741531185599394439863864773280788,
+        0.586087235467691130294144845693013,
+        0.405845151377397166906606412076961,
+        0.207784955007898467600689403773245,
+        0.0,
+    };
+
+    constexpr std::array KRONROD_WEIGHTS {
+        0.022935322010529224963732008058970,
+        0.063092092629978553290700663189204,
+        0.104790010322250183839876322541518,
+        0.140653259715525918745189590510238,
+        0.169004726639267902826583426598550,
+        0.190350578064785409913256402421014,
+        0.204432940075298892414161999234649,
+        0.209482141084727828012999174891714,
+    };
+
+    // The weights of the 7 point Gauss rule at KRONROD_NODES[1], [3], [5], and [7].
+    constexpr std::array GAUSS_WEIGHTS {
+        0.129484966168869693270611432679082,
+        0.279705391489276667901467771423780,
+        0.381830050505118944950369775488975,
+        0.417959183673469387755102040816327,
+    };
+
+    constexpr std::size_t NODES_PER_INTERVAL = 15;
+
+    // Below this many subintervals per thread, starting a thread costs more than it saves.
+    constexpr std::size_t MIN_INTERVALS_PER_THREAD = 64;
+
+    struct Subinterval {
+        double lower;
+        double upper;
+        double value = 0.0;
+        double error = 0.0;
+    };
+
+    /**
+     * Writes the Kronrod nodes of each interval to `abscissae`, the center of an interval first,
+     * followed by each pair of nodes symmetric about it.
+     */
+    auto PlaceNodes(std::span<const Subinterval> intervals, std::span<double> abscissae) -> void
+    {
+        for (std::size_t i = 0; i < intervals.size(); ++i) {
+            const double center = (intervals[i].lower + intervals[i].upper) / 2.0;
+            const double halfWidth = (intervals[i].upper - intervals[i].lower) / 2.0;
+            double* nodes = abscissae.data() + i * NODES_PER_INTERVAL;
+
+            nodes[0] = center;
+            for (std::size_t j = 0; j < KRONROD_NODES.size() - 1; ++j) {
+                nodes[1 + 2 * j] = center - halfWidth * KRONROD_NODES[j];
+                nodes[2 + 2 * j] = center + halfWidth * KRONROD_NODES[j];
+            }
+        }
+    }
+
+    /**
+     * Computes the integral of an interval and its error from the values of the integrand at its
+     * nodes.
+     */
+    auto Estimate(Subinterval& interval, std::span<const double> values) -> void
+    {
+        double kronrod = KRONROD_WEIGHTS.back() * values[0];
+        double gauss = GAUSS_WEIGHTS.back() * values[0];
+
+        for (std::size_t j = 0; j < KRONROD_NODES.size() - 1; ++j) {
+            const double pair = values[1 + 2 * j] + values[2 + 2 * j];
+            kronrod += KRONROD_WEIGHTS[j] * pair;
+
+            if (j % 2 == 1) {
+                gauss += GAUSS_WEIGHTS[j / 2] * pair;
+            }
+        }
+
+        const double halfWidth = (interval.upper - interval.lower) / 2.0;
+        interval.value = kronrod * halfWidth;
+        interval.error = std::abs((kronrod - gauss) * halfWidth);
+    }
+
+    /**
+     * Integrates every interval, evaluating the integrand at all of their nodes in batches, one
+     * batch per thread.
+     */
+    auto EstimateAll(const CompiledExpression& integrand, std::span<Subinterval> intervals, std::size_t threads) -> void
+    {
+        std::vector<double> abscissae(intervals.size() * NODES_PER_INTERVAL);
+        std::vector<double> values(abscissae.size());
+        PlaceNodes(intervals, abscissae);
+
+        const auto evaluate = [&integrand, &abscissae, &values](std::size_t begin, std::size_t end) {
+            const std::array columns { std::span<const double> { abscissae }.subspan(begin, end - begin) };
+            integrand.EvaluateBatch(columns, std::span { values }.subspan(begin, end - begin));
+        };
+
+        const std::size_t batches = std::clamp<std::size_t>(intervals.size() / MIN_INTERVALS_PER_THREAD, 1, threads);
+        if (batches == 1) {
+            evaluate(0, abscissae.size());
+        } else {
+            const std::size_t intervalsPerBatch = (intervals.size() + batches - 1) / batches;
+
+            std::vector<std::jthread> workers;
+            for (std::size_t batch = 1; batch < batches; ++batch) {
+                const std::size_t begin = batch * intervalsPerBatch * NODES_PER_INTERVAL;
+                const std::size_t end = std::min(begin + intervalsPerBatch * NODES_PER_INTERVAL, abscissae.size());
+                if (begin < end) {
+                    workers.emplace_back(evaluate, begin, end);
+                }
+            }
+
+            evaluate(0, intervalsPerBatch * NODES_PER_INTERVAL);
+        }
+
+        for (std::size_t i = 0; i < intervals.size(); ++i) {
+            Estimate(intervals[i], std::span { values }.subspan(i * NODES_PER_INTERVAL, NODES_PER_INTERVAL));
+        }
+    }
+
+    auto Sum(std::span<const Subinterval> intervals, double Subinterval::*member) -> double
+    {
+        return std::accumulate(intervals.begin(), intervals.end(), 0.0, [member](double sum, const Subinterval& interval) {
+            return sum + interval.*member;
+        });
+    }
+
+} // namespace
+
+auto Quadrature(const CompiledExpression& integrand, double lower, double upper, const QuadratureOpts& opts) -> QuadratureResult
+{
+    if (integrand.GetVariableCount() > 1) {
+        throw std::invalid_argument("The integrand must have at most one variable.");
+    }
+
+    if (!std::isfinite(lower) || !std::isfinite(upper)) {
+        throw std::invalid_argument("The bounds of integration must be finite.");
+    }
+
+    if (lower == upper) {
+        return {};
+    }
+
+    if (lower > upper) {
+        auto result = Quadrature(integrand, upper, lower, opts);
+        result.value = -result.value;
+        return result;
+    }
+
+    const std::size_t threads = opts.threads != 0 ? opts.threads : std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t maxIntervals = std::max<std::size_t>(opts.maxIntervals, 1);
+    const double width = upper - lower;
+
+    std::vector<Subinterval> intervals { Subinterval { lower, upper } };
+    EstimateAll(integrand, intervals, threads);
+
+    std::vector<std::size_t> bisected;
+    std::vector<Subinterval> halves;
+
+    while (true) {
+        const double value = Sum(intervals, &Subinterval::value);
+        const double error = Sum(intervals, &Subinterval::error);
+        const double tolerance = std::max(opts.absoluteTolerance, opts.relativeTolerance * std::abs(value));
+
+        const bool converged = error <= tolerance;
+        if (converged || !std::isfinite(value) || !std::isfinite(error) || intervals.size() >= maxIntervals) {
+            return QuadratureResult { value, error, intervals.size(), converged };
+        }
+
+        // Each interval may contribute to the error in proportion to its width.
+        bisected.clear();
+        for (std::size_t i = 0; i < intervals.size(); ++i) {
+            const Subinterval& interval = intervals[i];
+            if (interval.error > tolerance * (interval.upper - interval.lower) / width) {
+                bisected.push_back(i);
+            }
+        }
+
+        // The shares and the total error are rounded, so no interval may exceed its share even
+        // though the total error exceeds the tolerance. The worst interval is bisected then, so
+        // that every pass makes progress.
+        if (bisected.empty()) {
+            bisected.push_back(static_cast<std::size_t>(std::ranges::max_element(intervals, {}, &Subinterval::error) - intervals.begin()));
+        }
+
+        const std::size_t capacity = maxIntervals - intervals.size();
+        if (bisected.size() > capacity) {
+            std::ranges::partial_sort(bisected, bisected.begin() + static_cast<std::ptrdiff_t>(capacity), std::ranges::greater {}, [&intervals](std::size_t i) {
+                return intervals[i].error;
+            });
+            bisected.resize(capacity);
+        }
+
+        halves.clear();
+        for (const std::size_t i : bisected) {
+            const double midpoint = (intervals[i].lower + intervals[i].upper) / 2.0;
+            halves.push_back(Subinterval { intervals[i].lower, midpoint });
+            halves.push_back(Subinterval { midpoint, intervals[i].upper });
+        }
+
+        EstimateAll(integrand, halves, threads);
+
+        for (std::size_t k = 0; k < bisected.size(); ++k) {
+            intervals[bisected[k]] = halves[2 * k];
+            intervals.push_back(halves[2 * k + 1]);
+        }
+    }
+}
+
+auto EvaluateDefiniteIntegral(const Expression& integrand, const Variable& variable, const Expression& lower, const Expression& upper, const QuadratureOpts& opts) -> std::expected<QuadratureResult, std::string>
+{
+    SimplifyVisitor simplifyVisitor {};
+
+    auto simplifiedLower = lower.Accept(simplifyVisitor);
+    auto simplifiedUpper = upper.Accept(simplifyVisitor);
+    if (!simplifiedLower || !simplifiedUpper) {
+        return std::unexpected { !simplifiedLower ? simplifiedLower.error() : simplifiedUpper.error() };
+    }
+
+    if (!(*simplifiedLower)->Is<Real>() || !(*simplifiedUpper)->Is<Real>()) {
+        return std::unexpected { "The bounds of integration must be numbers." };
+    }
+
+    const double lowerValue = static_cast<const Real&>(**simplifiedLower).GetValue();
+    const double upperValue = static_cast<const Real&>(**simplifiedUpper).GetValue();
+    if (!std::isfinite(lowerValue) || !std::isfinite(upperValue)) {
+        return std::unexpected { "The bounds of integration must be finite." };
+    }
+
+    const std::array variables { variable };
+    const auto compiledIntegrand = Compile(integrand, variables);
+    if (!compiledIntegrand) {
+        return std::unexpected { compiledIntegrand.error() };
+    }
+
+    // The antiderivative gives the integral only where the integrand is continuous, so it is used
+    // only when the integrand is bounded on the interval, which rules out a pole inside it.
+    const std::array range { Interval { std::min(lowerValue, upperValue), std::max(lowerValue, upperValue) } };
+    const Interval bound = compiledIntegrand->EvaluateInterval(range);
+    if (std::isfinite(bound.lower) && std::isfinite(bound.upper)) {
+        // The antiderivative is taken without a constant of integration, whose name could clash
+        // with the variable of integration.
+        IntegrateVisitor integrateVisitor { variable, simplifyVisitor };
+        if (const auto antiderivative = integrateVisitor.Antiderivative(integrand)) {
+            if (auto compiled = Compile(*antiderivative, variables)) {
+                const double difference = (*compiled)(std::array { upperValue }) - (*compiled)(std::array { lowerValue });
+                if (std::isfinite(difference)) {
+                    return QuadratureResult { difference, 0.0, 0, true };
+                }
+            }
+        }
+    }
+
+    return Quadrature(*compiledIntegrand, lowerValue, upperValue, opts);
+}
+
+} // Oasis
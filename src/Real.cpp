@@ -28,6 +28,12 @@ auto Real::Equals(const Expression& other) const -> bool
     return other.Is<Real>() && value == dynamic_cast<const Real&>(other).value;
 }
 
+auto Real::Hash() const -> std::size_t
+{
+    // 0.0 and -0.0 compare equal, so they must hash equally
+    return HashCombine(HashType(ExpressionType::Real), std::hash<double> {}(value == 0.0 ? 0.0 : value));
+}
+
 auto Real::GetValue() const -> double
 {
     return value;
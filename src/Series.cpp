@@ -0,0 +1,334 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numbers>
+
+#include "Oasis/Series.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    // The coefficients of a power series in (variable - point), truncated to a fixed order.
+    using Coefficients = std::vector<double>;
+    using SeriesResult = std::expected<Coefficients, std::string>;
+
+    auto IsConstant(const Coefficients& series) -> bool
+    {
+        return std::all_of(series.begin() + 1, series.end(), [](double coefficient) { return coefficient == 0.0; });
+    }
+
+    auto Product(const Coefficients& lhs, const Coefficients& rhs) -> Coefficients
+    {
+        Coefficients product(lhs.size());
+        for (std::size_t k = 0; k < product.size(); ++k) {
+            for (std::size_t i = 0; i <= k; ++i) {
+                product[k] += lhs[i] * rhs[k - i];
+            }
+        }
+
+        return product;
+    }
+
+    auto Quotient(const Coefficients& dividend, const Coefficients& divisor) -> SeriesResult
+    {
+        if (divisor[0] == 0.0) {
+            return std::unexpected { "The expression has a pole at the point of expansion." };
+        }
+
+        Coefficients quotient(dividend.size());
+        for (std::size_t k = 0; k < quotient.size(); ++k) {
+            double sum = dividend[k];
+            for (std::size_t i = 1; i <= k; ++i) {
+                sum -= divisor[i] * quotient[k - i];
+            }
+            quotient[k] = sum / divisor[0];
+        }
+
+        return quotient;
+    }
+
+    // w = e^a satisfies w' = a' w.
+    auto Exp(const Coefficients& series) -> Coefficients
+    {
+        Coefficients result(series.size());
+        result[0] = std::exp(series[0]);
+        for (std::size_t k = 1; k < result.size(); ++k) {
+            double sum = 0.0;
+            for (std::size_t i = 1; i <= k; ++i) {
+                sum += static_cast<double>(i) * series[i] * result[k - i];
+            }
+            result[k] = sum / static_cast<double>(k);
+        }
+
+        return result;
+    }
+
+    // w = ln(a) satisfies a w' = a'.
+    auto Ln(const Coefficients& series) -> SeriesResult
+    {
+        if (series[0] <= 0.0) {
+            return std::unexpected { "The logarithm is not analytic at the point of expansion." };
+        }
+
+        Coefficients result(series.size());
+        result[0] = std::log(series[0]);
+        for (std::size_t k = 1; k < result.size(); ++k) {
+            double sum = static_cast<double>(k) * series[k];
+            for (std::size_t i = 1; i < k; ++i) {
+                sum -= static_cast<double>(i) * result[i] * series[k - i];
+            }
+            result[k] = sum / (static_cast<double>(k) * series[0]);
+        }
+
+        return result;
+    }
+
+    // s = sin(a) and c = cos(a) satisfy s' = a' c and c' = -a' s, so they are computed together.
+    auto Sin(const Coefficients& series) -> Coefficients
+    {
+        Coefficients sine(series.size());
+        Coefficients cosine(series.size());
+        sine[0] = std::sin(series[0]);
+        cosine[0] = std::cos(series[0]);
+        for (std::size_t k = 1; k < sine.size(); ++k) {
+            double sineSum = 0.0;
+            double cosineSum = 0.0;
+            for (std::size_t i = 1; i <= k; ++i) {
+                sineSum += static_cast<double>(i) * series[i] * cosine[k - i];
+                cosineSum += static_cast<double>(i) * series[i] * sine[k - i];
+            }
+            sine[k] = sineSum / static_cast<double>(k);
+            cosine[k] = -cosineSum / static_cast<double>(k);
+        }
+
+        return sine;
+    }
+
+    // w = a^p satisfies a w' = p a' w.
+    auto Pow(const Coefficients& base, double power) -> SeriesResult
+    {
+        if (base[0] == 0.0) {
+            if (power < 0.0 || power != std::floor(power)) {
+                return std::unexpected { "The power is not analytic at the point of expansion." };
+            }
+
+            Coefficients result(base.size());
+            result[0] = 1.0;
+            Coefficients square = base;
+            for (auto exponent = static_cast<std::uint64_t>(power); exponent != 0; exponent /= 2) {
+                if (exponent % 2 == 1) {
+                    result = Product(result, square);
+                }
+                if (exponent > 1) {
+                    square = Product(square, square);
+                }
+            }
+            return result;
+        }
+
+        if (base[0] < 0.0 && power != std::floor(power)) {
+            return std::unexpected { "The power is not real at the point of expansion." };
+        }
+
+        Coefficients result(base.size());
+        result[0] = std::pow(base[0], power);
+        for (std::size_t k = 1; k < result.size(); ++k) {
+            double sum = 0.0;
+            for (std::size_t i = 1; i <= k; ++i) {
+                sum += (power * static_cast<double>(i) - static_cast<double>(k - i)) * base[i] * result[k - i];
+            }
+            result[k] = sum / (static_cast<double>(k) * base[0]);
+        }
+
+        return result;
+    }
+
+    class SeriesExpansion {
+    public:
+        SeriesExpansion(const Variable& variable, double point, std::size_t order)
+            : variable(variable)
+            , point(point)
+            , order(order)
+        {
+        }
+
+        auto Expand(const Expression& expression) const -> SeriesResult
+        {
+            switch (expression.GetType()) {
+            case ExpressionType::Real:
+                return Constant(static_cast<const Real&>(expression).GetValue());
+            case ExpressionType::Pi:
+                return Constant(std::numbers::pi);
+            case ExpressionType::EulerNumber:
+                return Constant(std::numbers::e);
+            case ExpressionType::Variable: {
+                if (static_cast<const Variable&>(expression).GetName() != variable.GetName()) {
+                    return std::unexpected { "The expression depends on a variable other than " + variable.GetName() + "." };
+                }
+
+                Coefficients series = Constant(point);
+                if (order > 0) {
+                    series[1] = 1.0;
+                }
+                return series;
+            }
+            case ExpressionType::Add:
+                return Binary(expression, [](Coefficients lhs, const Coefficients& rhs) -> SeriesResult {
+                    std::ranges::transform(lhs, rhs, lhs.begin(), std::plus {});
+                    return lhs;
+                });
+            case ExpressionType::Subtract:
+                return Binary(expression, [](Coefficients lhs, const Coefficients& rhs) -> SeriesResult {
+                    std::ranges::transform(lhs, rhs, lhs.begin(), std::minus {});
+                    return lhs;
+                });
+            case ExpressionType::Multiply:
+                return Binary(expression, [](const Coefficients& lhs, const Coefficients& rhs) -> SeriesResult {
+                    return Product(lhs, rhs);
+                });
+            case ExpressionType::Divide:
+                return Binary(expression, Quotient);
+            case ExpressionType::Exponent:
+                return Binary(expression, [](const Coefficients& base, const Coefficients& power) -> SeriesResult {
+                    if (IsConstant(power)) {
+                        return Pow(base, power[0]);
+                    }
+
+                    // a^b = e^(b ln(a))
+                    return Ln(base).transform([&power](const Coefficients& lnBase) {
+                        return Exp(Product(power, lnBase));
+                    });
+                });
+            case ExpressionType::Log:
+                return Binary(expression, [](const Coefficients& base, const Coefficients& argument) -> SeriesResult {
+                    auto lnArgument = Ln(argument);
+                    auto lnBase = lnArgument ? Ln(base) : lnArgument;
+                    return lnBase ? Quotient(*lnArgument, *lnBase) : lnBase;
+                });
+            case ExpressionType::Negate:
+                return Expand(*expression.GetOperandAt(0)).transform([](Coefficients series) {
+                    std::ranges::transform(series, series.begin(), std::negate {});
+                    return series;
+                });
+            case ExpressionType::Sine:
+                return Expand(*expression.GetOperandAt(0)).transform(Sin);
+            case ExpressionType::Magnitude:
+                return Expand(*expression.GetOperandAt(0)).and_then([](Coefficients series) -> SeriesResult {
+                    if (series[0] == 0.0) {
+                        return std::unexpected { "The magnitude is not analytic at the point of expansion." };
+                    }
+
+                    if (series[0] < 0.0) {
+                        std::ranges::transform(series, series.begin(), std::negate {});
+                    }
+                    return series;
+                });
+            default:
+                return std::unexpected { "Series expansion does not support this expression." };
+            }
+        }
+
+    private:
+        [[nodiscard]] auto Constant(double value) const -> Coefficients
+        {
+            Coefficients series(order + 1);
+            series[0] = value;
+            return series;
+        }
+
+        template <typename Combine>
+        auto Binary(const Expression& expression, Combine combine) const -> SeriesResult
+        {
+            auto lhs = Expand(*expression.GetOperandAt(0));
+            if (!lhs) {
+                return lhs;
+            }
+
+            auto rhs = Expand(*expression.GetOperandAt(1));
+            if (!rhs) {
+                return rhs;
+            }
+
+            return combine(std::move(*lhs), *rhs);
+        }
+
+        const Variable& variable;
+        double point;
+        std::size_t order;
+    };
+
+} // namespace
+
+auto SeriesCoefficients(const Expression& expression, const Variable& variable, double point, std::size_t order) -> std::expected<std::vector<double>, std::string>
+{
+    if (!std::isfinite(point)) {
+        return std::unexpected { "The point of expansion must be finite." };
+    }
+
+    return SeriesExpansion { variable, point, order }.Expand(expression);
+}
+
+auto Series(const Expression& expression, const Variable& variable, const Expression& point, std::size_t order) -> std::expected<std::unique_ptr<Expression>, std::string>
+{
+    SimplifyVisitor simplifyVisitor {};
+    auto simplifiedPoint = point.Accept(simplifyVisitor);
+    if (!simplifiedPoint) {
+        return std::unexpected { simplifiedPoint.error() };
+    }
+
+    if (!(*simplifiedPoint)->Is<Real>()) {
+        return std::unexpected { "The point of expansion must be a number." };
+    }
+
+    const double pointValue = static_cast<const Real&>(**simplifiedPoint).GetValue();
+    const auto coefficients = SeriesCoefficients(expression, variable, pointValue, order);
+    if (!coefficients) {
+        return std::unexpected { coefficients.error() };
+    }
+
+    // The powers are of the variable itself when expanding about zero.
+    const std::unique_ptr<Expression> displacement = pointValue == 0.0
+        ? variable.Copy()
+        : std::make_unique<Subtract<>>(variable, Real { pointValue });
+
+    std::unique_ptr<Expression> polynomial;
+    for (std::size_t k = 0; k < coefficients->size(); ++k) {
+        const double coefficient = (*coefficients)[k];
+        if (coefficient == 0.0) {
+            continue;
+        }
+
+        std::unique_ptr<Expression> term;
+        if (k == 0) {
+            term = std::make_unique<Real>(coefficient);
+        } else if (k == 1) {
+            term = std::make_unique<Multiply<>>(Real { coefficient }, *displacement);
+        } else {
+            term = std::make_unique<Multiply<>>(Real { coefficient }, Exponent<> { *displacement, Real { static_cast<double>(k) } });
+        }
+
+        polynomial = polynomial ? std::make_unique<Add<>>(*polynomial, *term) : std::move(term);
+    }
+
+    if (!polynomial) {
+        return std::make_unique<Real>(0.0);
+    }
+
+    return polynomial;
+}
+
+} // Oasis
@@ -3,15 +3,24 @@
 //
 
 #include <format>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Oasis/SimplifyVisitor.hpp"
 
 #include "Oasis/Add.hpp"
+#include "Oasis/CommonSubexpression.hpp"
 #include "Oasis/Derivative.hpp"
+#include "Oasis/DifferentiateVisitor.hpp"
 #include "Oasis/Divide.hpp"
 #include "Oasis/EulerNumber.hpp"
 #include "Oasis/Exponent.hpp"
+#include "Oasis/Hash.hpp"
 #include "Oasis/Integral.hpp"
+#include "Oasis/IntegrateVisitor.hpp"
 #include "Oasis/Log.hpp"
 #include "Oasis/Magnitude.hpp"
 #include "Oasis/MatchCast.hpp"
@@ -19,6 +28,7 @@
 #include "Oasis/Negate.hpp"
 #include "Oasis/Pi.hpp"
 #include "Oasis/Real.hpp"
+#include "Oasis/RecursiveMatch.hpp"
 #include "Oasis/Sine.hpp"
 #include "Oasis/Subtract.hpp"
 #include "Oasis/Undefined.hpp"
@@ -30,6 +40,87 @@ constexpr auto EPSILON = std::numeric_limits<float>::epsilon();
 
 namespace Oasis {
 
+namespace {
+
+    /**
+     * Adds the coefficients of two like terms, folding them directly when both are real.
+     */
+    auto SumCoefficients(SimplifyVisitor& visitor, const Expression& lhs, const Expression& rhs) -> SimplifyVisitor::RetT
+    {
+        if (lhs.Is<Real>() && rhs.Is<Real>()) {
+            const double sum = static_cast<const Real&>(lhs).GetValue() + static_cast<const Real&>(rhs).GetValue();
+            return gsl_lite::not_null { std::make_unique<Real>(sum) };
+        }
+
+        return Add<Expression> { lhs, rhs }.Accept(visitor);
+    }
+
+    /**
+     * The like terms of a sum or product, keyed by the part of each term that is not its coefficient.
+     *
+     * In a sum, the key of `3x` is `x` and its coefficient is `3`. In a product, the key of `x^3` is `x`
+     * and its coefficient is the exponent `3`. Keys are found through a hash map, so collecting n terms
+     * takes linear time rather than comparing every pair of terms. Terms keep the order in which they
+     * first appear, and keys refer into the expression being simplified.
+     */
+    struct LikeTerms {
+        struct Term {
+            // nullptr for the folded constant and for terms that are kept as is.
+            const Expression* key;
+            std::unique_ptr<Expression> coefficient;
+        };
+
+        /**
+         * Adds a coefficient to the term with the given key, or starts a new term.
+         */
+        auto Collect(SimplifyVisitor& visitor, const Expression& key, const Expression& coefficient) -> std::expected<void, std::string>
+        {
+            auto [it, inserted] = index.try_emplace(&key, terms.size());
+            if (inserted) {
+                terms.push_back({ &key, coefficient.Generalize() });
+                return {};
+            }
+
+            auto sum = SumCoefficients(visitor, *terms[it->second].coefficient, coefficient);
+            if (!sum) {
+                return std::unexpected { sum.error() };
+            }
+
+            terms[it->second].coefficient = sum.value()->Copy();
+            return {};
+        }
+
+        /**
+         * Folds a real into the constant term using op.
+         */
+        template <typename OpT>
+        auto FoldConstant(const Real& real, OpT op) -> void
+        {
+            if (!constant) {
+                constant = terms.size();
+                terms.push_back({ nullptr, real.Generalize() });
+                return;
+            }
+
+            auto& folded = terms[*constant].coefficient;
+            folded = std::make_unique<Real>(op(static_cast<const Real&>(*folded).GetValue(), real.GetValue()));
+        }
+
+        /**
+         * Keeps a term that is not collected with any other.
+         */
+        auto Keep(std::unique_ptr<Expression> term) -> void
+        {
+            terms.push_back({ nullptr, std::move(term) });
+        }
+
+        std::vector<Term> terms;
+        std::unordered_map<const Expression*, std::size_t, ExpressionHash, ExpressionEqual> index;
+        std::optional<std::size_t> constant;
+    };
+
+} // namespace
+
 SimplifyVisitor::SimplifyVisitor()
 {
     options = SimplifyOpts {};
@@ -38,6 +129,9 @@ SimplifyVisitor::SimplifyVisitor()
 SimplifyVisitor::SimplifyVisitor(SimplifyOpts& opts)
     : options(opts)
 {
+    if (options.memoCapacity > 0) {
+        memo = std::make_shared<ExpressionCache<std::shared_ptr<const Expression>>>(options.memoCapacity);
+    }
 }
 
 SimplifyOpts SimplifyVisitor::GetOptions() const
@@ -45,6 +139,126 @@ SimplifyOpts SimplifyVisitor::GetOptions() const
     return options;
 }
 
+auto SimplifyVisitor::GetMemoSize() const -> std::size_t
+{
+    return memo ? memo->Size() : 0;
+}
+
+template <typename T>
+auto SimplifyVisitor::Memoize(const T& expression) -> RetT
+{
+    // A node shared within the expression given to SimplifyShared is simplified once.
+    const auto shared = sharedResults.find(&expression);
+    const bool isShared = shared != sharedResults.end();
+    if (isShared && shared->second) {
+        return gsl_lite::not_null { shared->second->Copy() };
+    }
+
+    if (!memo && !isShared) {
+        return Simplify(expression);
+    }
+
+    if (const auto* cached = memo ? memo->Find(expression) : nullptr) {
+        return gsl_lite::not_null { (*cached)->Copy() };
+    }
+
+    auto simplified = Simplify(expression);
+    if (simplified) {
+        std::shared_ptr<const Expression> result { simplified.value()->Copy() };
+
+        if (memo) {
+            memo->Insert(expression, result);
+        }
+
+        // Simplifying the operands may have rehashed the results, so the node is looked up again.
+        if (isShared) {
+            sharedResults[&expression] = std::move(result);
+        }
+    }
+
+    return simplified;
+}
+
+auto SimplifyVisitor::SimplifyShared(const Expression& expression) -> RetT
+{
+    const auto shared = EliminateCommonSubexpressions(expression);
+
+    // An enclosing call's nodes are set aside rather than merged, since its results are still
+    // pending and it restores them when this call returns.
+    auto enclosingResults = std::exchange(sharedResults, {});
+
+    std::vector<const Expression*> pending { shared.get() };
+    while (!pending.empty()) {
+        const Expression* node = pending.back();
+        pending.pop_back();
+
+        for (std::size_t i = 0; const Expression* op = node->GetOperandAt(i); ++i) {
+            if (sharedResults.try_emplace(op).second) {
+                pending.push_back(op);
+            }
+        }
+    }
+
+    auto simplified = shared->Accept(*this);
+    sharedResults = std::move(enclosingResults);
+    return simplified;
+}
+
+auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
+{
+    return Memoize(add);
+}
+
+auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
+{
+    return Memoize(subtract);
+}
+
+auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
+{
+    return Memoize(multiply);
+}
+
+auto SimplifyVisitor::TypedVisit(const Divide<>& divide) -> RetT
+{
+    return Memoize(divide);
+}
+
+auto SimplifyVisitor::TypedVisit(const Exponent<>& exponent) -> RetT
+{
+    return Memoize(exponent);
+}
+
+auto SimplifyVisitor::TypedVisit(const Log<>& log) -> RetT
+{
+    return Memoize(log);
+}
+
+auto SimplifyVisitor::TypedVisit(const Negate<Expression>& negate) -> RetT
+{
+    return Memoize(negate);
+}
+
+auto SimplifyVisitor::TypedVisit(const Sine<Expression>& sine) -> RetT
+{
+    return Memoize(sine);
+}
+
+auto SimplifyVisitor::TypedVisit(const Derivative<>& derivative) -> RetT
+{
+    return Memoize(derivative);
+}
+
+auto SimplifyVisitor::TypedVisit(const Integral<>& integral) -> RetT
+{
+    return Memoize(integral);
+}
+
+auto SimplifyVisitor::TypedVisit(const Magnitude<Expression>& magnitude) -> RetT
+{
+    return Memoize(magnitude);
+}
+
 auto SimplifyVisitor::TypedVisit(const Real& real) -> RetT
 {
     return gsl_lite::not_null { std::make_unique<Real>(real) };
@@ -65,19 +279,17 @@ auto SimplifyVisitor::TypedVisit(const Undefined&) -> RetT
     return gsl_lite::not_null { std::make_unique<Undefined>() };
 }
 
-auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
+auto SimplifyVisitor::Simplify(const Add<>& add) -> RetT
 {
-    auto mostSigOp = add.GetMostSigOp().Copy();
-    auto leastSigOp = add.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!add.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!add.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedAugendResult = mostSigOp->Accept(*this);
-    auto simplifiedAddendResult = leastSigOp->Accept(*this);
+    auto simplifiedAugendResult = add.GetMostSigOp().Accept(*this);
+    auto simplifiedAddendResult = add.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedAugendResult) {
         return std::unexpected { simplifiedAugendResult.error() };
@@ -91,20 +303,20 @@ auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
 
     Add simplifiedAdd { *simplifiedAugend, *simplifiedAddend };
 
-    if (auto realCase = RecursiveCast<Add<Real>>(simplifiedAdd); realCase != nullptr) {
+    if (auto realCase = RecursiveMatch<Add<Real>>(simplifiedAdd); realCase != nullptr) {
         const Real& firstReal = realCase->GetMostSigOp();
         const Real& secondReal = realCase->GetLeastSigOp();
 
         return gsl_lite::not_null { std::make_unique<Real>(firstReal.GetValue() + secondReal.GetValue()) };
     }
 
-    if (auto zeroCase = RecursiveCast<Add<Real, Expression>>(simplifiedAdd); zeroCase != nullptr) {
+    if (auto zeroCase = RecursiveMatch<Add<Real, Expression>>(simplifiedAdd); zeroCase != nullptr) {
         if (zeroCase->GetMostSigOp().GetValue() == 0) {
             return gsl_lite::not_null { zeroCase->GetLeastSigOp().Generalize() };
         }
     }
 
-    if (auto likeTermsCase = RecursiveCast<Add<Multiply<Real, Expression>>>(simplifiedAdd); likeTermsCase != nullptr) {
+    if (auto likeTermsCase = RecursiveMatch<Add<Multiply<Real, Expression>>>(simplifiedAdd); likeTermsCase != nullptr) {
         const Oasis::IExpression auto& leftTerm = likeTermsCase->GetMostSigOp().GetLeastSigOp();
         const Oasis::IExpression auto& rightTerm = likeTermsCase->GetLeastSigOp().GetLeastSigOp();
 
@@ -117,7 +329,7 @@ auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
     }
 
     // matrix + matrix
-    if (auto matrixCase = RecursiveCast<Add<Matrix, Matrix>>(simplifiedAdd); matrixCase != nullptr) {
+    if (auto matrixCase = RecursiveMatch<Add<Matrix, Matrix>>(simplifiedAdd); matrixCase != nullptr) {
         const Oasis::IExpression auto& leftTerm = matrixCase->GetMostSigOp();
         const Oasis::IExpression auto& rightTerm = matrixCase->GetLeastSigOp();
 
@@ -129,7 +341,7 @@ auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
     }
 
     // log(a) + log(b) = log(ab)
-    if (auto logCase = RecursiveCast<Add<Log<Expression, Expression>, Log<Expression, Expression>>>(simplifiedAdd); logCase != nullptr) {
+    if (auto logCase = RecursiveMatch<Add<Log<Expression, Expression>, Log<Expression, Expression>>>(simplifiedAdd); logCase != nullptr) {
         if (logCase->GetMostSigOp().GetMostSigOp().Equals(logCase->GetLeastSigOp().GetMostSigOp())) {
             const IExpression auto& base = logCase->GetMostSigOp().GetMostSigOp();
             const IExpression auto& argument = Multiply<Expression>({ logCase->GetMostSigOp().GetLeastSigOp(), logCase->GetLeastSigOp().GetLeastSigOp() });
@@ -143,7 +355,7 @@ auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
     }
 
     // 2x + x = 3x
-    if (const auto likeTermsCase2 = RecursiveCast<Add<Multiply<Real, Expression>, Expression>>(simplifiedAdd); likeTermsCase2 != nullptr) {
+    if (const auto likeTermsCase2 = RecursiveMatch<Add<Multiply<Real, Expression>, Expression>>(simplifiedAdd); likeTermsCase2 != nullptr) {
         if (likeTermsCase2->GetMostSigOp().GetLeastSigOp().Equals(likeTermsCase2->GetLeastSigOp())) {
             const Real& coeffiecent = likeTermsCase2->GetMostSigOp().GetMostSigOp();
             return gsl_lite::not_null { std::make_unique<Multiply<Real, Expression>>(Real { coeffiecent.GetValue() + 1 }, likeTermsCase2->GetMostSigOp().GetLeastSigOp()) };
@@ -152,151 +364,53 @@ auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
 
     // simplifies expressions and combines like terms
     // ex: 1 + 2x + 3 + 5x = 4 + 7x (or 7x + 4)
-    std::vector<std::unique_ptr<Expression>> adds;
-    std::vector<std::unique_ptr<Expression>> vals;
-    simplifiedAdd.Flatten(adds);
-    for (const auto& addend : adds) {
+    LikeTerms likeTerms;
+    for (const Expression* addend : simplifiedAdd.FlattenView()) {
+        std::expected<void, std::string> collected;
+
         // real
-        size_t i = 0;
-        if (auto real = RecursiveCast<Real>(*addend); real != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Real>(*vals[i]); valI != nullptr) {
-                    vals[i] = Real { valI->GetValue() + real->GetValue() }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(addend->Generalize());
-            }
-            continue;
+        if (const Real* real = RecursiveMatch<Real>(*addend); real != nullptr) {
+            likeTerms.FoldConstant(*real, std::plus {});
         }
         // single i
-        if (auto img = RecursiveCast<Imaginary>(*addend); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Multiply<Expression, Imaginary>>(*vals[i]); valI != nullptr) {
-                    auto addResult = Add<Expression> { valI->GetMostSigOp(), Real { 1.0 } }.Accept(*this);
-                    if (!addResult) {
-                        return addResult;
-                    }
-                    vals[i] = Multiply<Expression> { *(addResult.value()), Imaginary {} }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Multiply<Expression> { Real { 1.0 }, Imaginary {} }.Generalize());
-            }
-            continue;
+        else if (addend->Is<Imaginary>()) {
+            collected = likeTerms.Collect(*this, *addend, Real { 1.0 });
         }
         // n*i
-        if (auto img = RecursiveCast<Multiply<Expression, Imaginary>>(*addend); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Multiply<Expression, Imaginary>>(*vals[i]); valI != nullptr) {
-                    auto addResult = Add<Expression> { valI->GetMostSigOp(), img->GetMostSigOp() }.Accept(*this);
-                    if (!addResult) {
-                        return addResult;
-                    }
-                    vals[i] = Multiply<Expression> { *(addResult.value()), Imaginary {} }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(img->Generalize());
-            }
-            continue;
+        else if (auto img = RecursiveMatch<Multiply<Expression, Imaginary>>(*addend); img != nullptr) {
+            collected = likeTerms.Collect(*this, img->GetLeastSigOp(), img->GetMostSigOp());
         }
         // single variable
-        if (auto var = RecursiveCast<Variable>(*addend); var != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Multiply<Expression, Variable>>(*vals[i]); valI != nullptr) {
-                    if (valI->GetLeastSigOp().GetName() == var->GetName()) {
-                        auto addResult = Add<Expression> { valI->GetMostSigOp(), Real { 1.0 } }.Accept(*this);
-                        if (!addResult) {
-                            return addResult;
-                        }
-                        vals[i] = Multiply<Expression> { *(addResult.value()), *var }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Multiply<Expression> { Real { 1.0 }, *var }.Generalize());
-            }
-            continue;
+        else if (addend->Is<Variable>()) {
+            collected = likeTerms.Collect(*this, *addend, Real { 1.0 });
         }
         // n*variable
-        if (auto var = RecursiveCast<Multiply<Expression, Variable>>(*addend); var != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Multiply<Expression, Variable>>(*vals[i]); valI != nullptr) {
-                    // if (auto zeroCase = RecursiveCast<Multiply<Real, Expression>>(*valI); zeroCase != nullptr) {}
-                    if (valI->GetLeastSigOp().GetName() == var->GetLeastSigOp().GetName()) {
-                        auto addResult = Add<Expression> { valI->GetMostSigOp(), var->GetMostSigOp() }.Accept(*this);
-                        if (!addResult) {
-                            return addResult;
-                        }
-                        vals[i] = Multiply<Expression> { *(addResult.value()), valI->GetLeastSigOp() }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(var->Generalize());
-            }
-            continue;
+        else if (auto var = RecursiveMatch<Multiply<Expression, Variable>>(*addend); var != nullptr) {
+            collected = likeTerms.Collect(*this, var->GetLeastSigOp(), var->GetMostSigOp());
         }
         // single exponent
-        if (auto exp = RecursiveCast<Exponent<Expression>>(*addend); exp != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Multiply<Expression, Exponent<Expression>>>(*vals[i]); valI != nullptr) {
-                    if (valI->GetLeastSigOp().Equals(*exp)) {
-                        auto addResult = Add<Expression> { valI->GetMostSigOp(), Real { 1.0 } }.Accept(*this);
-                        if (!addResult) {
-                            return addResult;
-                        }
-                        vals[i] = Multiply<Expression> { *(addResult.value()), *exp }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Multiply<Expression> { Real { 1.0 }, *exp }.Generalize());
-            }
-            continue;
+        else if (addend->Is<Exponent>()) {
+            collected = likeTerms.Collect(*this, *addend, Real { 1.0 });
         }
         // n*exponent
-        if (auto exp = RecursiveCast<Multiply<Expression, Exponent<Expression>>>(*addend); exp != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Multiply<Expression, Exponent<Expression>>>(*vals[i]); valI != nullptr) {
-                    if (valI->GetLeastSigOp().Equals(exp->GetLeastSigOp())) {
-                        auto addResult = Add<Expression> { valI->GetMostSigOp(), exp->GetMostSigOp() }.Accept(*this);
-                        if (!addResult) {
-                            return addResult;
-                        }
-                        vals[i] = Multiply<Expression> { *(addResult.value()), valI->GetLeastSigOp() }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(exp->Generalize());
-            }
-            continue;
+        else if (auto exp = RecursiveMatch<Multiply<Expression, Exponent<Expression>>>(*addend); exp != nullptr) {
+            collected = likeTerms.Collect(*this, exp->GetLeastSigOp().GetExpression(), exp->GetMostSigOp());
         }
         // no simplification possible
         else {
-            vals.push_back(addend->Copy()->Generalize());
+            likeTerms.Keep(addend->Generalize());
+        }
+
+        if (!collected) {
+            return std::unexpected { collected.error() };
         }
     }
+
+    std::vector<std::unique_ptr<Expression>> vals;
+    for (auto& [key, coefficient] : likeTerms.terms) {
+        vals.push_back(key ? Multiply<Expression> { *coefficient, *key }.Generalize() : std::move(coefficient));
+    }
+
     // rebuild equation after simplification.
 
     for (auto& val : vals) {
@@ -323,26 +437,24 @@ auto SimplifyVisitor::TypedVisit(const Add<>& add) -> RetT
         avals.push_back(val->Generalize());
     }
 
-    if (auto vec = BuildFromVector<Add>(avals); vec != nullptr) {
+    if (auto vec = BuildFromVector<Add>(std::move(avals)); vec != nullptr) {
         return gsl_lite::not_null { std::move(vec) };
     }
 
     return gsl_lite::not_null { simplifiedAdd.Copy() };
 }
 
-auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
+auto SimplifyVisitor::Simplify(const Subtract<>& subtract) -> RetT
 {
-    auto mostSigOp = subtract.GetMostSigOp().Copy();
-    auto leastSigOp = subtract.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!subtract.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!subtract.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = subtract.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = subtract.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -357,7 +469,7 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
     const Subtract simplifiedSubtract { *simplifiedMinuend, *simplifiedSubtrahend };
 
     // 2 - 1 = 1
-    if (auto realCase = RecursiveCast<Subtract<Real>>(simplifiedSubtract); realCase != nullptr) {
+    if (auto realCase = RecursiveMatch<Subtract<Real>>(simplifiedSubtract); realCase != nullptr) {
         const Real& minuend = realCase->GetMostSigOp();
         const Real& subtrahend = realCase->GetLeastSigOp();
 
@@ -369,7 +481,7 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
         return gsl_lite::not_null { std::make_unique<Real>(Real { 0.0 }) };
     }
 
-    if (auto matrixCase = RecursiveCast<Subtract<Matrix, Matrix>>(simplifiedSubtract); matrixCase != nullptr) {
+    if (auto matrixCase = RecursiveMatch<Subtract<Matrix, Matrix>>(simplifiedSubtract); matrixCase != nullptr) {
         const Oasis::IExpression auto& leftTerm = matrixCase->GetMostSigOp();
         const Oasis::IExpression auto& rightTerm = matrixCase->GetLeastSigOp();
 
@@ -381,7 +493,7 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
     }
 
     // ax - x = (a-1)x
-    if (const auto minusOneCase = RecursiveCast<Subtract<Multiply<>, Expression>>(simplifiedSubtract); minusOneCase != nullptr) {
+    if (const auto minusOneCase = RecursiveMatch<Subtract<Multiply<>, Expression>>(simplifiedSubtract); minusOneCase != nullptr) {
         if (minusOneCase->GetMostSigOp().GetLeastSigOp().Equals(minusOneCase->GetLeastSigOp())) {
             const Subtract newCoefficient { minusOneCase->GetMostSigOp().GetMostSigOp(), Real { 1.0 } };
             return Multiply { newCoefficient, minusOneCase->GetLeastSigOp() }.Accept(*this);
@@ -389,7 +501,7 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
     }
 
     // x-ax = (1-a)x
-    if (const auto oneMinusCase = RecursiveCast<Subtract<Expression, Multiply<>>>(simplifiedSubtract); oneMinusCase != nullptr) {
+    if (const auto oneMinusCase = RecursiveMatch<Subtract<Expression, Multiply<>>>(simplifiedSubtract); oneMinusCase != nullptr) {
         if (oneMinusCase->GetMostSigOp().Equals(oneMinusCase->GetLeastSigOp().GetLeastSigOp())) {
             const Subtract newCoefficient { Real { 1.0 }, oneMinusCase->GetLeastSigOp().GetMostSigOp() };
             return Multiply { newCoefficient, oneMinusCase->GetMostSigOp() }.Accept(*this);
@@ -397,7 +509,7 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
     }
 
     // ax-bx= (a-b)x
-    if (const auto coefficientCase = RecursiveCast<Subtract<Multiply<>>>(simplifiedSubtract); coefficientCase != nullptr) {
+    if (const auto coefficientCase = RecursiveMatch<Subtract<Multiply<>>>(simplifiedSubtract); coefficientCase != nullptr) {
         if (coefficientCase->GetMostSigOp().GetLeastSigOp().Equals(coefficientCase->GetLeastSigOp().GetLeastSigOp())) {
             const Subtract newCoefficient { coefficientCase->GetMostSigOp().GetMostSigOp(), coefficientCase->GetLeastSigOp().GetMostSigOp() };
             return Multiply { newCoefficient, coefficientCase->GetLeastSigOp().GetLeastSigOp() }.Accept(*this);
@@ -405,7 +517,7 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
     }
 
     // log(a) - log(b) = log(a / b)
-    if (const auto logCase = RecursiveCast<Subtract<Log<>>>(simplifiedSubtract); logCase != nullptr) {
+    if (const auto logCase = RecursiveMatch<Subtract<Log<>>>(simplifiedSubtract); logCase != nullptr) {
         if (logCase->GetMostSigOp().GetMostSigOp().Equals(logCase->GetLeastSigOp().GetMostSigOp())) {
             const IExpression auto& base = logCase->GetMostSigOp().GetMostSigOp();
             const IExpression auto& argument = Divide({ logCase->GetMostSigOp().GetLeastSigOp(), logCase->GetLeastSigOp().GetLeastSigOp() });
@@ -450,19 +562,17 @@ auto SimplifyVisitor::TypedVisit(const Subtract<>& subtract) -> RetT
     return Add { *simplifiedMinuend, negated }.Accept(*this);
 }
 
-auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
+auto SimplifyVisitor::Simplify(const Multiply<>& multiply) -> RetT
 {
-    auto mostSigOp = multiply.GetMostSigOp().Copy();
-    auto leastSigOp = multiply.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!multiply.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!multiply.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = multiply.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = multiply.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -475,7 +585,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     auto simplifiedMultiplier = std::move(simplifiedLeastSigOpResult).value();
 
     Multiply simplifiedMultiply { *simplifiedMultiplicand, *simplifiedMultiplier };
-    if (auto onezerocase = RecursiveCast<Multiply<Real, Expression>>(simplifiedMultiply); onezerocase != nullptr) {
+    if (auto onezerocase = RecursiveMatch<Multiply<Real, Expression>>(simplifiedMultiply); onezerocase != nullptr) {
         const Real& multiplicand = onezerocase->GetMostSigOp();
         const Expression& multiplier = onezerocase->GetLeastSigOp();
         if (std::abs(multiplicand.GetValue()) <= EPSILON) {
@@ -485,17 +595,17 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
             return multiplier.Accept(*this);
         }
     }
-    if (auto realCase = RecursiveCast<Multiply<Real>>(simplifiedMultiply); realCase != nullptr) {
+    if (auto realCase = RecursiveMatch<Multiply<Real>>(simplifiedMultiply); realCase != nullptr) {
         const Real& multiplicand = realCase->GetMostSigOp();
         const Real& multiplier = realCase->GetLeastSigOp();
         return gsl_lite::not_null { std::make_unique<Real>(multiplicand.GetValue() * multiplier.GetValue()) };
     }
 
-    if (auto ImgCase = RecursiveCast<Multiply<Imaginary>>(simplifiedMultiply); ImgCase != nullptr) {
+    if (auto ImgCase = RecursiveMatch<Multiply<Imaginary>>(simplifiedMultiply); ImgCase != nullptr) {
         return gsl_lite::not_null { std::make_unique<Real>(-1.0) };
     }
 
-    if (auto multCase = RecursiveCast<Multiply<Real, Divide<Expression>>>(simplifiedMultiply); multCase != nullptr) {
+    if (auto multCase = RecursiveMatch<Multiply<Real, Divide<Expression>>>(simplifiedMultiply); multCase != nullptr) {
         auto m = Multiply<Expression> { multCase->GetMostSigOp(), multCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
         if (!m) {
             return m;
@@ -503,17 +613,17 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         return gsl_lite::not_null { Divide<Expression> { *(m.value()), (multCase->GetLeastSigOp().GetLeastSigOp()) }.Generalize() };
     }
 
-    if (auto exprCase = RecursiveCast<Multiply<Expression>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Expression>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().Equals(exprCase->GetLeastSigOp())) {
             return gsl_lite::not_null { std::make_unique<Exponent<Expression, Expression>>(exprCase->GetMostSigOp(), Real { 2.0 }) };
         }
     }
 
-    if (auto rMatrixCase = RecursiveCast<Multiply<Real, Matrix>>(simplifiedMultiply); rMatrixCase != nullptr) {
+    if (auto rMatrixCase = RecursiveMatch<Multiply<Real, Matrix>>(simplifiedMultiply); rMatrixCase != nullptr) {
         return gsl_lite::not_null { std::make_unique<Matrix>(rMatrixCase->GetLeastSigOp().GetMatrix() * rMatrixCase->GetMostSigOp().GetValue()) };
     }
 
-    if (auto matrixCase = RecursiveCast<Multiply<Matrix, Matrix>>(simplifiedMultiply); matrixCase != nullptr) {
+    if (auto matrixCase = RecursiveMatch<Multiply<Matrix, Matrix>>(simplifiedMultiply); matrixCase != nullptr) {
         const Oasis::IExpression auto& leftTerm = matrixCase->GetMostSigOp();
         const Oasis::IExpression auto& rightTerm = matrixCase->GetLeastSigOp();
 
@@ -525,7 +635,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         }
     }
 
-    if (auto multCase = RecursiveCast<Multiply<Expression, Divide<Expression>>>(simplifiedMultiply); multCase != nullptr) {
+    if (auto multCase = RecursiveMatch<Multiply<Expression, Divide<Expression>>>(simplifiedMultiply); multCase != nullptr) {
         auto m = Multiply<Expression> { multCase->GetMostSigOp(), multCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
         if (!m) {
             return m;
@@ -533,8 +643,8 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         return Divide<Expression> { *(m.value()), (multCase->GetLeastSigOp().GetLeastSigOp()) }.Accept(*this);
     }
 
-    if (auto multCase = RecursiveCast<Multiply<Divide<Expression>, Divide<Expression>>>(simplifiedMultiply); multCase != nullptr) {
-        auto m = Multiply<Expression> { multCase->GetMostSigOp(), multCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
+    if (auto multCase = RecursiveMatch<Multiply<Divide<Expression>, Divide<Expression>>>(simplifiedMultiply); multCase != nullptr) {
+        auto m = Multiply<Expression> { multCase->GetMostSigOp().GetExpression(), multCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
         if (!m) {
             return m;
         }
@@ -545,7 +655,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         return Divide<Expression> { *(m.value()), *(n.value()) }.Accept(*this);
     }
 
-    if (auto exprCase = RecursiveCast<Multiply<Expression, Exponent<Expression, Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Expression, Exponent<Expression, Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
             if (!lsOp) {
@@ -556,7 +666,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // x*x^n
-    if (auto exprCase = RecursiveCast<Multiply<Expression, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Expression, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
             if (!lsOp) {
@@ -566,7 +676,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         }
     }
 
-    if (auto exprCase = RecursiveCast<Multiply<Exponent<Expression>, Expression>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Exponent<Expression>, Expression>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetLeastSigOp().Equals(exprCase->GetMostSigOp().GetMostSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
             if (!lsOp) {
@@ -577,7 +687,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // x^n*x^m
-    if (auto exprCase = RecursiveCast<Multiply<Exponent<Expression>, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Exponent<Expression>, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Accept(*this);
             if (!lsOp) {
@@ -588,7 +698,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x*x
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression>, Expression>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression>, Expression>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp())) {
             return gsl_lite::not_null { std::make_unique<Multiply<Expression, Expression>>(exprCase->GetMostSigOp().GetMostSigOp(),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 2.0 } }) };
@@ -596,7 +706,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x*b*x
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression>, Multiply<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression>, Multiply<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp())) {
             auto msOp = Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
             if (!msOp) {
@@ -611,7 +721,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x^n*x
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression, Exponent<Expression>>, Expression>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression, Exponent<Expression>>, Expression>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
             if (!lsOp) {
@@ -623,7 +733,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x*x^n
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression>, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression>, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
             if (!lsOp) {
@@ -643,7 +753,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x^n*b*x
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression>, Multiply<Expression, Exponent<Expression>>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression>, Multiply<Expression, Exponent<Expression>>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp().GetMostSigOp())) {
             auto msOp = Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
             if (!msOp) {
@@ -658,7 +768,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         }
     }
 
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression>, Multiply<Exponent<Expression>, Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression>, Multiply<Exponent<Expression>, Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp().GetMostSigOp())) {
             auto msOp = Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Accept(*this);
             if (!msOp) {
@@ -673,7 +783,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         }
     }
 
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp())) {
             auto msOp = Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Accept(*this);
             if (!msOp) {
@@ -690,7 +800,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x^n*x^m
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression, Exponent<Expression>>, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression, Exponent<Expression>>, Exponent<Expression>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp())) {
             auto lsOp = Add<Expression> { exprCase->GetLeastSigOp().GetMostSigOp(), exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp() }.Accept(*this);
             if (!lsOp) {
@@ -704,7 +814,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // a*x^n*b*x^m
-    if (auto exprCase = RecursiveCast<Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression, Exponent<Expression>>>>(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = RecursiveMatch<Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression, Exponent<Expression>>>>(simplifiedMultiply); exprCase != nullptr) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp().GetMostSigOp())) {
             auto msOp = Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetMostSigOp() }.Accept(*this);
             if (!msOp) {
@@ -721,7 +831,7 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         }
     }
 
-    if (auto mul = RecursiveCast<Multiply<Real, Add<>>>(simplifiedMultiply); mul != nullptr) {
+    if (auto mul = RecursiveMatch<Multiply<Real, Add<>>>(simplifiedMultiply); mul != nullptr) {
         auto lhs = mul->GetMostSigOp();
         auto rhs = mul->GetLeastSigOp();
         if (options.distributivePolicy == SimplifyOpts::DistributivePolicy::PREFER
@@ -733,104 +843,33 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
     }
 
     // multiply add like terms
-    std::vector<std::unique_ptr<Expression>> multiplies;
-    std::vector<std::unique_ptr<Expression>> vals;
-    simplifiedMultiply.Flatten(multiplies);
-    for (const auto& multiplicand : multiplies) {
-        size_t i = 0;
-        if (auto real = RecursiveCast<Real>(*multiplicand); real != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Real>(*vals[i]); valI != nullptr) {
-                    vals[i] = Real { valI->GetValue() * real->GetValue() }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(multiplicand->Generalize());
-            }
-            continue;
-        }
-        // single i
-        if (auto img = RecursiveCast<Imaginary>(*multiplicand); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Exponent<Imaginary, Expression>>(*vals[i]); valI != nullptr) {
-                    auto lsOp = Add<Expression> { valI->GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
-                    if (!lsOp) {
-                        return lsOp;
-                    }
-                    vals[i] = Exponent<Expression> { Imaginary {}, *(lsOp.value()) }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Exponent<Expression> { Imaginary {}, Real { 1.0 } }.Generalize());
-            }
-            continue;
+    // powers of a common base are collected by adding their exponents
+    LikeTerms likeTerms;
+    for (const Expression* multiplicand : simplifiedMultiply.FlattenView()) {
+        std::expected<void, std::string> collected;
+
+        if (const Real* real = RecursiveMatch<Real>(*multiplicand); real != nullptr) {
+            likeTerms.FoldConstant(*real, std::multiplies {});
         }
-        // i^n
-        if (auto img = RecursiveCast<Exponent<Imaginary, Expression>>(*multiplicand); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Exponent<Imaginary, Expression>>(*vals[i]); valI != nullptr) {
-                    auto lsOp = Add<Expression> { valI->GetLeastSigOp(), img->GetLeastSigOp() }.Accept(*this);
-                    if (!lsOp) {
-                        return lsOp;
-                    }
-                    vals[i] = Exponent<Expression> { Imaginary {}, *(lsOp.value()) }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                // vals.push_back(Multiply<Expression> { img->GetMostSigOp(), Imaginary {} }.Generalize());
-                vals.push_back(img->Generalize());
-            }
-            continue;
+        // expr^n, including i^n
+        else if (auto expr = RecursiveMatch<Exponent<Expression, Expression>>(*multiplicand); expr != nullptr) {
+            collected = likeTerms.Collect(*this, expr->GetMostSigOp(), expr->GetLeastSigOp());
         }
-        // expr^n
-        if (auto expr = RecursiveCast<Exponent<Expression, Expression>>(*multiplicand); expr != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Exponent<Expression, Expression>>(*vals[i]); valI != nullptr) {
-                    if (valI->GetMostSigOp().Equals(expr->GetMostSigOp())) {
-                        auto lsOp = Add<Expression> { valI->GetLeastSigOp(), expr->GetLeastSigOp() }.Accept(*this);
-                        if (!lsOp) {
-                            return lsOp;
-                        }
-                        vals[i] = Exponent<Expression> { valI->GetMostSigOp(), *(lsOp.value()) }.Generalize();
-                        break;
-                    }
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                // vals.push_back(Multiply<Expression> { img->GetMostSigOp(), Imaginary {} }.Generalize());
-                vals.push_back(expr->Generalize());
-            }
-            continue;
+        // single expr, including i
+        else {
+            collected = likeTerms.Collect(*this, *multiplicand, Real { 1.0 });
         }
-        // single expr
-        if (auto expr = RecursiveCast<Expression>(*multiplicand); expr != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = RecursiveCast<Exponent<Expression, Expression>>(*vals[i]); valI != nullptr) {
-                    auto lsOp = Add<Expression> { valI->GetLeastSigOp(), Real { 1.0 } }.Accept(*this);
-                    if (!lsOp) {
-                        return lsOp;
-                    }
-                    if (valI->GetMostSigOp().Equals(*expr)) {
-                        vals[i] = Exponent<Expression> { valI->GetMostSigOp(), *(lsOp.value()) }.Generalize();
-                        break;
-                    }
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Exponent<Expression> { *expr, Real { 1.0 } }.Generalize());
-            }
-            continue;
+
+        if (!collected) {
+            return std::unexpected { collected.error() };
         }
     }
 
+    std::vector<std::unique_ptr<Expression>> vals;
+    for (auto& [base, exponent] : likeTerms.terms) {
+        vals.push_back(base ? Exponent<Expression> { *base, *exponent }.Generalize() : std::move(exponent));
+    }
+
     // makes all expr^1 into expr
     for (auto& val : vals) {
         if (auto exp = RecursiveCast<Exponent<Expression, Real>>(*val); exp != nullptr) {
@@ -845,22 +884,20 @@ auto SimplifyVisitor::TypedVisit(const Multiply<>& multiply) -> RetT
         }
     }
 
-    return gsl_lite::not_null { BuildFromVector<Multiply>(vals) };
+    return gsl_lite::not_null { BuildFromVector<Multiply>(std::move(vals)) };
 }
 
-auto SimplifyVisitor::TypedVisit(const Divide<>& divide) -> RetT
+auto SimplifyVisitor::Simplify(const Divide<>& divide) -> RetT
 {
-    auto mostSigOp = divide.GetMostSigOp().Copy();
-    auto leastSigOp = divide.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!divide.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!divide.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = divide.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = divide.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -874,14 +911,14 @@ auto SimplifyVisitor::TypedVisit(const Divide<>& divide) -> RetT
 
     Divide simplifiedDivide { *simplifiedDividend, *simplifiedDivider };
 
-    if (auto realCase = RecursiveCast<Divide<Real>>(simplifiedDivide); realCase != nullptr) {
+    if (auto realCase = RecursiveMatch<Divide<Real>>(simplifiedDivide); realCase != nullptr) {
         const Real& dividend = realCase->GetMostSigOp();
         const Real& divisor = realCase->GetLeastSigOp();
         return gsl_lite::not_null { std::make_unique<Real>(dividend.GetValue() / divisor.GetValue()) };
     }
 
     // log(a)/log(b)=log[b](a)
-    if (auto logCase = RecursiveCast<Divide<Log<Expression, Expression>, Log<Expression, Expression>>>(simplifiedDivide); logCase != nullptr) {
+    if (auto logCase = RecursiveMatch<Divide<Log<Expression, Expression>, Log<Expression, Expression>>>(simplifiedDivide); logCase != nullptr) {
         if (logCase->GetMostSigOp().GetMostSigOp().Equals(logCase->GetLeastSigOp().GetMostSigOp())) {
             const IExpression auto& base = logCase->GetLeastSigOp().GetLeastSigOp();
             const IExpression auto& argument = logCase->GetMostSigOp().GetLeastSigOp();
@@ -1116,8 +1153,8 @@ auto SimplifyVisitor::TypedVisit(const Divide<>& divide) -> RetT
         }
     }
 
-    auto dividend = numeratorVals.size() == 1 ? std::move(numeratorVals.front()) : BuildFromVector<Multiply>(numeratorVals);
-    auto divisor = denominatorVals.size() == 1 ? std::move(denominatorVals.front()) : BuildFromVector<Multiply>(denominatorVals);
+    auto dividend = numeratorVals.size() == 1 ? std::move(numeratorVals.front()) : BuildFromVector<Multiply>(std::move(numeratorVals));
+    auto divisor = denominatorVals.size() == 1 ? std::move(denominatorVals.front()) : BuildFromVector<Multiply>(std::move(denominatorVals));
 
     // rebuild subtrees
     if (!dividend && divisor)
@@ -1132,12 +1169,11 @@ auto SimplifyVisitor::TypedVisit(const Divide<>& divide) -> RetT
     return gsl_lite::not_null { Divide { *dividend, *divisor }.Copy() };
 }
 
-auto SimplifyVisitor::TypedVisit(const Exponent<>& exponent) -> RetT
+auto SimplifyVisitor::Simplify(const Exponent<>& exponent) -> RetT
 {
     static auto match_cast = MatchCast<Expression>()
                                  .Case(
                                      [](const Exponent<Expression, Real>& zeroCase) -> bool {
-                                         // TODO: Optimize. We're calling RecursiveCast<Expression<Real, Expression> twice. Perhaps a map of expression types to a vector of lambdas?
                                          const Real& power = zeroCase.GetLeastSigOp();
                                          return power.GetValue() == 0.0;
                                      },
@@ -1222,17 +1258,15 @@ auto SimplifyVisitor::TypedVisit(const Exponent<>& exponent) -> RetT
                                          return gsl_lite::make_not_null(logCase.GetLeastSigOp().GetLeastSigOp().Copy());
                                      });
 
-    auto mostSigOp = exponent.GetMostSigOp().Copy();
-    auto leastSigOp = exponent.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!exponent.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!exponent.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = exponent.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = exponent.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -1249,20 +1283,17 @@ auto SimplifyVisitor::TypedVisit(const Exponent<>& exponent) -> RetT
     return gsl_lite::not_null { matchResult ? std::move(matchResult) : std::move(simplifiedExponent.Copy()) };
 }
 
-auto SimplifyVisitor::TypedVisit(const Log<>& logIn) -> RetT
+auto SimplifyVisitor::Simplify(const Log<>& logIn) -> RetT
 {
-    auto mostSigOp = logIn.GetMostSigOp().Copy();
-    auto leastSigOp = logIn.GetLeastSigOp().Copy();
-
-    if (!mostSigOp) {
+    if (!logIn.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!logIn.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = logIn.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = logIn.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -1276,13 +1307,13 @@ auto SimplifyVisitor::TypedVisit(const Log<>& logIn) -> RetT
 
     const Log simplifiedLog { *simplifiedBase, *simplifiedPower };
 
-    if (const auto realBaseCase = RecursiveCast<Log<Real, Expression>>(simplifiedLog); realBaseCase != nullptr) {
+    if (const auto realBaseCase = RecursiveMatch<Log<Real, Expression>>(simplifiedLog); realBaseCase != nullptr) {
         if (const Real& b = realBaseCase->GetMostSigOp(); b.GetValue() <= 0.0 || b.GetValue() == 1) {
             return gsl_lite::not_null { std::make_unique<Undefined>() };
         }
     }
 
-    if (const auto realExponentCase = RecursiveCast<Log<Expression, Real>>(simplifiedLog); realExponentCase != nullptr) {
+    if (const auto realExponentCase = RecursiveMatch<Log<Expression, Real>>(simplifiedLog); realExponentCase != nullptr) {
         const Real& argument = realExponentCase->GetLeastSigOp();
 
         if (argument.GetValue() <= 0.0) {
@@ -1294,7 +1325,7 @@ auto SimplifyVisitor::TypedVisit(const Log<>& logIn) -> RetT
         }
     }
 
-    if (const auto realCase = RecursiveCast<Log<Real>>(simplifiedLog); realCase != nullptr) {
+    if (const auto realCase = RecursiveMatch<Log<Real>>(simplifiedLog); realCase != nullptr) {
         const Real& base = realCase->GetMostSigOp();
         const Real& argument = realCase->GetLeastSigOp();
 
@@ -1302,21 +1333,21 @@ auto SimplifyVisitor::TypedVisit(const Log<>& logIn) -> RetT
     }
 
     // log(a) with a < 0 log(-a)
-    if (auto negCase = RecursiveCast<Log<Expression, Real>>(simplifiedLog); negCase != nullptr) {
+    if (auto negCase = RecursiveMatch<Log<Expression, Real>>(simplifiedLog); negCase != nullptr) {
         if (negCase->GetLeastSigOp().GetValue() < 0) {
             return gsl_lite::not_null { Add<Expression> { Log { negCase->GetMostSigOp(), Real { -1 * negCase->GetLeastSigOp().GetValue() } }, Multiply<Expression> { Imaginary {}, Pi {} } }.Generalize() };
         }
     }
 
     // log[a](a) = 1
-    if (const auto sameCase = RecursiveCast<Log<Expression, Expression>>(simplifiedLog); sameCase != nullptr) {
-        if (sameCase->leastSigOp->Equals(*sameCase->mostSigOp)) {
+    if (const auto sameCase = RecursiveMatch<Log<Expression, Expression>>(simplifiedLog); sameCase != nullptr) {
+        if (sameCase->GetLeastSigOp().Equals(sameCase->GetMostSigOp())) {
             return gsl_lite::not_null { Real { 1 }.Generalize() };
         }
     }
 
     // log[a](b^x) = x * log[a](b)
-    if (const auto expCase = RecursiveCast<Log<Expression, Exponent<>>>(simplifiedLog); expCase != nullptr) {
+    if (const auto expCase = RecursiveMatch<Log<Expression, Exponent<>>>(simplifiedLog); expCase != nullptr) {
         const auto exponent = expCase->GetLeastSigOp();
         const IExpression auto& log = Log<Expression>(expCase->GetMostSigOp(), exponent.GetMostSigOp()); // might need to check that it isnt nullptr
         const IExpression auto& factor = exponent.GetLeastSigOp();
@@ -1326,14 +1357,13 @@ auto SimplifyVisitor::TypedVisit(const Log<>& logIn) -> RetT
     return gsl_lite::not_null { simplifiedLog.Copy() };
 }
 
-auto SimplifyVisitor::TypedVisit(const Negate<Expression>& negate) -> RetT
+auto SimplifyVisitor::Simplify(const Negate<Expression>& negate) -> RetT
 {
-    auto op = negate.GetOperand().Copy();
-    if (!op) {
+    if (!negate.HasOperand()) {
         return std::unexpected { "Missing operand." };
     }
 
-    auto simplifiedMostSigOpResult = op->Accept(*this);
+    auto simplifiedMostSigOpResult = negate.GetOperand().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -1344,14 +1374,13 @@ auto SimplifyVisitor::TypedVisit(const Negate<Expression>& negate) -> RetT
     return std::move(Multiply { Real { -1 }, *simplifiedOp }.Accept(*this)).value();
 }
 
-auto SimplifyVisitor::TypedVisit(const Sine<Expression>& sine) -> RetT
+auto SimplifyVisitor::Simplify(const Sine<Expression>& sine) -> RetT
 {
-    auto op = sine.GetOperand().Copy();
-    if (!op) {
+    if (!sine.HasOperand()) {
         return std::unexpected { "Missing operand." };
     }
 
-    auto simplifiedMostSigOpResult = op->Accept(*this);
+    auto simplifiedMostSigOpResult = sine.GetOperand().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return std::unexpected { simplifiedMostSigOpResult.error() };
@@ -1359,22 +1388,20 @@ auto SimplifyVisitor::TypedVisit(const Sine<Expression>& sine) -> RetT
 
     auto simplifiedOp = std::move(simplifiedMostSigOpResult).value();
 
-    return simplifiedOp->Accept(*this);
+    return gsl_lite::not_null { std::make_unique<Sine<Expression>>(*simplifiedOp) };
 }
 
-auto SimplifyVisitor::TypedVisit(const Derivative<>& derivative) -> RetT
+auto SimplifyVisitor::Simplify(const Derivative<>& derivative) -> RetT
 {
-    auto mostSigOp = derivative.GetMostSigOp().Copy();
-    auto leastSigOp = derivative.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!derivative.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!derivative.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = derivative.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = derivative.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return simplifiedMostSigOpResult;
@@ -1385,27 +1412,31 @@ auto SimplifyVisitor::TypedVisit(const Derivative<>& derivative) -> RetT
 
     auto simplifiedExpression = std::move(simplifiedMostSigOpResult).value();
     auto simplifiedVar = std::move(simplifiedLeastSigOpResult).value();
-    auto simplifiedDiff = simplifiedExpression->Differentiate(*simplifiedVar);
-    auto s = simplifiedDiff->Accept(*this);
-    if (!s) {
-        return s;
+
+    if (simplifiedVar->Is<Variable>()) {
+        DifferentiateVisitor differentiateVisitor { static_cast<const Variable&>(*simplifiedVar), *this };
+        return simplifiedExpression->Accept(differentiateVisitor);
     }
-    return gsl_lite::not_null { std::move(s).value()->Accept(*this).value() };
+
+    auto simplifiedDiff = simplifiedExpression->Differentiate(*simplifiedVar);
+
+    // The chain, product, and quotient rules copy operands into several terms, so higher
+    // derivatives repeat the same subexpressions many times over. Sharing them keeps the work
+    // proportional to the number of distinct subexpressions.
+    return SimplifyShared(*simplifiedDiff);
 }
 
-auto SimplifyVisitor::TypedVisit(const Integral<>& integral) -> RetT
+auto SimplifyVisitor::Simplify(const Integral<>& integral) -> RetT
 {
-    auto mostSigOp = integral.GetMostSigOp().Copy();
-    auto leastSigOp = integral.GetLeastSigOp().Copy();
-    if (!mostSigOp) {
+    if (!integral.HasMostSigOp()) {
         return std::unexpected { "Missing most significant operand." };
     }
-    if (!leastSigOp) {
+    if (!integral.HasLeastSigOp()) {
         return std::unexpected { "Missing least significant operand." };
     }
 
-    auto simplifiedMostSigOpResult = mostSigOp->Accept(*this);
-    auto simplifiedLeastSigOpResult = leastSigOp->Accept(*this);
+    auto simplifiedMostSigOpResult = integral.GetMostSigOp().Accept(*this);
+    auto simplifiedLeastSigOpResult = integral.GetLeastSigOp().Accept(*this);
 
     if (!simplifiedMostSigOpResult) {
         return simplifiedMostSigOpResult;
@@ -1417,6 +1448,11 @@ auto SimplifyVisitor::TypedVisit(const Integral<>& integral) -> RetT
     auto simplifiedIntegrand = std::move(simplifiedMostSigOpResult).value();
     auto simplifiedDifferential = std::move(simplifiedLeastSigOpResult).value();
 
+    if (simplifiedDifferential->Is<Variable>()) {
+        IntegrateVisitor integrateVisitor { static_cast<const Variable&>(*simplifiedDifferential), *this };
+        return simplifiedIntegrand->Accept(integrateVisitor);
+    }
+
     auto integrated = simplifiedIntegrand->Integrate(*simplifiedDifferential);
     return gsl_lite::not_null { std::move(integrated) };
 }
@@ -1436,7 +1472,7 @@ auto SimplifyVisitor::TypedVisit(const Pi&) -> RetT
     return gsl_lite::not_null { Pi {}.Copy() };
 }
 
-auto SimplifyVisitor::TypedVisit(const Magnitude<Expression>& magnitude) -> RetT
+auto SimplifyVisitor::Simplify(const Magnitude<Expression>& magnitude) -> RetT
 {
     auto simplified = magnitude.GetOperand().Accept(*this);
     if (!simplified) {
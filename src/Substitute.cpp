@@ -0,0 +1,138 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include "Oasis/Substitute.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    /**
+     * Substitutes values for variables, yielding nullptr for subtrees that are left unchanged so
+     * that the caller can share them.
+     */
+    class SubstituteVisitor final : public TypedVisitor<std::shared_ptr<const Expression>> {
+    public:
+        explicit SubstituteVisitor(const std::unordered_map<std::string, const Expression*>& values)
+        {
+            for (const auto& [name, value] : values) {
+                replacements.emplace(name, std::shared_ptr<const Expression> { value->Copy() });
+            }
+        }
+
+        auto TypedVisit(const Real&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Imaginary&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Undefined&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Matrix&) -> RetT override { return nullptr; }
+        auto TypedVisit(const EulerNumber&) -> RetT override { return nullptr; }
+        auto TypedVisit(const Pi&) -> RetT override { return nullptr; }
+
+        auto TypedVisit(const Variable& variable) -> RetT override
+        {
+            auto it = replacements.find(variable.GetName());
+            return it != replacements.end() ? it->second : nullptr;
+        }
+
+        auto TypedVisit(const Add<Expression, Expression>& add) -> RetT override { return SubstituteBinary<Add>(add); }
+        auto TypedVisit(const Subtract<Expression, Expression>& subtract) -> RetT override { return SubstituteBinary<Subtract>(subtract); }
+        auto TypedVisit(const Multiply<Expression, Expression>& multiply) -> RetT override { return SubstituteBinary<Multiply>(multiply); }
+        auto TypedVisit(const Divide<Expression, Expression>& divide) -> RetT override { return SubstituteBinary<Divide>(divide); }
+        auto TypedVisit(const Exponent<Expression, Expression>& exponent) -> RetT override { return SubstituteBinary<Exponent>(exponent); }
+        auto TypedVisit(const Log<Expression, Expression>& log) -> RetT override { return SubstituteBinary<Log>(log); }
+        auto TypedVisit(const Negate<Expression>& negate) -> RetT override { return SubstituteUnary<Negate>(negate); }
+        auto TypedVisit(const Sine<Expression>& sine) -> RetT override { return SubstituteUnary<Sine>(sine); }
+        auto TypedVisit(const Derivative<Expression, Expression>& derivative) -> RetT override { return SubstituteBinary<Derivative>(derivative); }
+        auto TypedVisit(const Integral<Expression, Expression>& integral) -> RetT override { return SubstituteBinary<Integral>(integral); }
+        auto TypedVisit(const Magnitude<Expression>& magnitude) -> RetT override { return SubstituteUnary<Magnitude>(magnitude); }
+
+    private:
+        auto SubstituteOperand(const std::shared_ptr<const Expression>& op) -> RetT
+        {
+            return op ? op->Accept(*this).value() : nullptr;
+        }
+
+        template <template <typename, typename> typename T>
+        auto SubstituteBinary(const T<Expression, Expression>& binary) -> RetT
+        {
+            const auto mostSigOp = binary.GetMostSigOpPtr();
+            const auto leastSigOp = binary.GetLeastSigOpPtr();
+
+            auto substitutedMostSigOp = SubstituteOperand(mostSigOp);
+            auto substitutedLeastSigOp = SubstituteOperand(leastSigOp);
+
+            if (!substitutedMostSigOp && !substitutedLeastSigOp) {
+                return nullptr;
+            }
+
+            auto substituted = std::make_shared<T<Expression, Expression>>();
+
+            if (auto op = substitutedMostSigOp ? std::move(substitutedMostSigOp) : mostSigOp) {
+                substituted->SetMostSigOp(std::move(op));
+            }
+
+            if (auto op = substitutedLeastSigOp ? std::move(substitutedLeastSigOp) : leastSigOp) {
+                substituted->SetLeastSigOp(std::move(op));
+            }
+
+            return substituted;
+        }
+
+        template <template <typename> typename T>
+        auto SubstituteUnary(const T<Expression>& unary) -> RetT
+        {
+            auto substitutedOperand = SubstituteOperand(unary.GetOperandPtr());
+            if (!substitutedOperand) {
+                return nullptr;
+            }
+
+            auto substituted = std::make_shared<T<Expression>>();
+            substituted->SetOperand(std::move(substitutedOperand));
+            return substituted;
+        }
+
+        std::unordered_map<std::string, std::shared_ptr<const Expression>> replacements;
+    };
+
+} // namespace
+
+auto Substitute(const Expression& expression, const std::unordered_map<std::string, const Expression*>& values) -> std::unique_ptr<Expression>
+{
+    SubstituteVisitor visitor { values };
+    const auto substituted = expression.Accept(visitor).value();
+    return substituted ? substituted->Copy() : expression.Copy();
+}
+
+auto Substitute(const Expression& expression, const std::unordered_map<std::string, const Expression*>& values, SimplifyVisitor& simplifyVisitor) -> std::unique_ptr<Expression>
+{
+    auto substituted = Substitute(expression, values);
+
+    auto simplified = substituted->Accept(simplifyVisitor);
+    if (!simplified) {
+        return substituted;
+    }
+
+    return std::move(simplified.value());
+}
+
+} // Oasis
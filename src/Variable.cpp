@@ -23,6 +23,11 @@ auto Variable::Equals(const Expression& other) const -> bool
     return other.Is<Variable>() && name == dynamic_cast<const Variable&>(other).name;
 }
 
+auto Variable::Hash() const -> std::size_t
+{
+    return HashCombine(HashType(ExpressionType::Variable), std::hash<std::string> {}(name));
+}
+
 auto Variable::GetName() const -> std::string
 {
     return name;
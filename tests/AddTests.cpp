@@ -290,4 +290,31 @@ TEST_CASE("Complex Addition Associativity With Variables", "[Add][Associativity]
     const auto simplified = add.Accept(simplifyVisitor).value();
 
     REQUIRE(expected.Equals(*simplified));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Collecting Like Terms of a Large Polynomial", "[Add][Simplification]")
+{
+    // 10000 terms over 20 monomials, 2x^2 + 3x^3 + ... + 21x^21 + 2x^2 + ...
+    constexpr std::size_t termCount = 10000;
+    constexpr std::size_t monomialCount = 20;
+
+    std::vector<std::unique_ptr<Oasis::Expression>> terms;
+    for (std::size_t i = 0; i < termCount; ++i) {
+        const auto power = static_cast<double>(i % monomialCount + 2);
+        terms.push_back(std::make_unique<Oasis::Multiply<>>(Oasis::Real { power }, Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { power } }));
+    }
+
+    const auto polynomial = Oasis::BuildFromVector<Oasis::Add>(std::move(terms));
+    const auto simplified = polynomial->Accept(simplifyVisitor).value();
+
+    REQUIRE(simplified->Is<Oasis::Add>());
+    const auto& simplifiedAdd = static_cast<const Oasis::Add<>&>(*simplified);
+    REQUIRE(simplifiedAdd.FlattenView().size() == monomialCount);
+
+    for (std::size_t i = 0; i < monomialCount; ++i) {
+        const auto power = static_cast<double>(i + 2);
+        const auto repeats = static_cast<double>(termCount / monomialCount);
+        const Oasis::Multiply<> term { Oasis::Real { power * repeats }, Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { power } } };
+        REQUIRE(std::ranges::any_of(simplifiedAdd.FlattenView(), [&term](const Oasis::Expression* op) { return op->Equals(term); }));
+    }
+}
@@ -1,13 +1,21 @@
 //
 // Created by Matthew McCall on 10/6/23.
 //
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
 #include "catch2/catch_test_macros.hpp"
 
 #include "Oasis/Add.hpp"
+#include "Oasis/Hash.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Negate.hpp"
 #include "Oasis/Real.hpp"
 #include "Oasis/RecursiveCast.hpp"
+#include "Oasis/RecursiveMatch.hpp"
+#include "Oasis/Substitute.hpp"
+#include "Oasis/Subtract.hpp"
 #include "Oasis/Variable.hpp"
 #include "Oasis/SimplifyVisitor.hpp"
 
@@ -65,6 +73,34 @@ TEST_CASE("Specialize Recursively Considers Commutative Property", "[Symbolic]")
     REQUIRE(result2 != nullptr);
 }
 
+TEST_CASE("Recursive Match Considers Commutative Property", "[Symbolic]")
+{
+    Oasis::Add add {
+        Oasis::Add {
+            Oasis::Variable { "x" },
+            Oasis::Real { 2.0 } },
+        Oasis::Real { 3.0 }
+    };
+
+    auto match = Oasis::RecursiveMatch<Oasis::Add<Oasis::Real, Oasis::Add<Oasis::Real, Oasis::Variable>>>(add);
+    REQUIRE(match != nullptr);
+    REQUIRE(match->GetMostSigOp().GetValue() == 3.0);
+    REQUIRE(match->GetLeastSigOp().GetMostSigOp().GetValue() == 2.0);
+    REQUIRE(match->GetLeastSigOp().GetLeastSigOp().GetName() == "x");
+
+    // bindings refer into the matched expression rather than copies of it
+    REQUIRE(&match->GetExpression() == &add);
+    REQUIRE(&match->GetMostSigOp() == add.GetOperandAt(1));
+
+    REQUIRE(Oasis::RecursiveMatch<Oasis::Add<Oasis::Real, Oasis::Multiply<Oasis::Expression>>>(add) == nullptr);
+    REQUIRE(Oasis::RecursiveMatch<Oasis::Real>(add) == nullptr);
+    REQUIRE(Oasis::RecursiveMatch<Oasis::Expression>(add) == &add);
+
+    Oasis::Subtract subtract { Oasis::Real { 1.0 }, Oasis::Variable { "x" } };
+    REQUIRE(Oasis::RecursiveMatch<Oasis::Subtract<Oasis::Real, Oasis::Variable>>(subtract) != nullptr);
+    REQUIRE(Oasis::RecursiveMatch<Oasis::Subtract<Oasis::Variable, Oasis::Real>>(subtract) == nullptr);
+}
+
 TEST_CASE("Flatten Function", "[TreeManip]")
 {
     Oasis::Real real1 { 1.0 };
@@ -95,6 +131,33 @@ TEST_CASE("Flatten Function", "[TreeManip]")
     }
 }
 
+TEST_CASE("FlattenView Function", "[TreeManip]")
+{
+    Oasis::Add<> add {
+        Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } },
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "y" } },
+        Oasis::Real { 3.0 }
+    };
+
+    const auto view = add.FlattenView();
+
+    REQUIRE(view.size() == 4);
+    REQUIRE(view[0]->Equals(Oasis::Real { 1.0 }));
+    REQUIRE(view[1]->Equals(Oasis::Variable { "x" }));
+    REQUIRE(view[2]->Is<Oasis::Multiply>());
+    REQUIRE(view[3]->Equals(Oasis::Real { 3.0 }));
+
+    // the view points into the expression rather than at copies
+    REQUIRE(view[3] == add.GetOperandAt(1));
+
+    std::vector<std::shared_ptr<const Oasis::Expression>> shared;
+    add.FlattenShared(shared);
+
+    REQUIRE(shared.size() == view.size());
+    REQUIRE(shared[2].get() == view[2]);
+    REQUIRE(shared[3].get() == view[3]);
+}
+
 TEST_CASE("BuildFromVector Function", "[TreeManip]")
 {
     Oasis::Real real1 { 1.0 };
@@ -170,6 +233,78 @@ TEST_CASE("BuildFromVector Function", "[TreeManip]")
     }
 }
 
+TEST_CASE("BuildFromVector moves operands", "[TreeManip]")
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> input;
+    for (int i = 1; i <= 4; ++i) {
+        input.emplace_back(Oasis::Real { static_cast<double>(i) }.Copy());
+    }
+
+    const Oasis::Expression* first = input.front().get();
+    const Oasis::Expression* last = input.back().get();
+
+    auto result = Oasis::BuildFromVector<Oasis::Add>(std::move(input), Oasis::TreeShape::LeftLeaning);
+
+    REQUIRE(result != nullptr);
+    REQUIRE(input.empty());
+
+    // ((1 + 2) + 3) + 4
+    Oasis::Add expected {
+        Oasis::Add {
+            Oasis::Add {
+                Oasis::Real { 1.0 },
+                Oasis::Real { 2.0 } },
+            Oasis::Real { 3.0 } },
+        Oasis::Real { 4.0 }
+    };
+
+    REQUIRE(result->StructurallyEquivalent(expected));
+    REQUIRE(&result->GetLeastSigOp() == last);
+
+    const auto* innermost = &result->GetMostSigOp();
+    while (innermost->Is<Oasis::Add>()) {
+        innermost = innermost->GetOperandAt(0);
+    }
+    REQUIRE(innermost == first);
+}
+
+TEST_CASE("N-ary storage", "[TreeManip]")
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> input;
+    for (int i = 0; i < 10000; ++i) {
+        input.emplace_back(Oasis::Real { static_cast<double>(i) }.Copy());
+    }
+
+    auto result = Oasis::BuildFromVector<Oasis::Add>(input);
+    REQUIRE(result != nullptr);
+    REQUIRE(result->GetOperandCount() == 10000);
+
+    std::vector<std::unique_ptr<Oasis::Expression>> flattened;
+    result->Flatten(flattened);
+    REQUIRE(flattened.size() == 10000);
+    REQUIRE(flattened.back()->Equals(Oasis::Real { 9999.0 }));
+
+    // the binary view splits at the largest power of two below the operand count
+    const auto& mostSigOp = static_cast<const Oasis::Add<>&>(result->GetMostSigOp());
+    REQUIRE(mostSigOp.GetOperandCount() == 8192);
+    REQUIRE(mostSigOp.GetMostSigOp().Is<Oasis::Add>());
+
+    // regrouping and reordering the operands does not change the hash
+    std::vector<std::unique_ptr<Oasis::Expression>> reversed;
+    for (auto it = input.rbegin(); it != input.rend(); ++it) {
+        reversed.emplace_back((*it)->Copy());
+    }
+    REQUIRE(result->Hash() == Oasis::BuildFromVector<Oasis::Add>(reversed)->Hash());
+    REQUIRE(result->Hash() == Oasis::Add<> { result->GetMostSigOp(), result->GetLeastSigOp() }.Hash());
+
+    // replacing an operand turns the n-ary expression into a binary one over its view
+    Oasis::Add<> replaced { *result };
+    replaced.SetLeastSigOp<Oasis::Expression>(Oasis::Variable { "x" });
+    REQUIRE(replaced.GetOperandCount() == 2);
+    REQUIRE(replaced.GetMostSigOp().Equals(mostSigOp));
+    REQUIRE(result->GetOperandCount() == 10000);
+}
+
 TEST_CASE("Equals follows associativity and commutativity")
 {
     Oasis::Real real1 { 1.0 };
@@ -235,4 +370,116 @@ TEST_CASE("Substitute Binary", "[Substitute]")
                     auto after = before.Substitute(Oasis::Variable { "x" }, Oasis::Real { 4.0 }); // after should some std::unique_ptr<Expression> such that it equals 2(4) + 3(4)
                     Oasis::Real twenty {20};
     REQUIRE(after->Equals(*(twenty.Accept(simplifyVisitor).value())));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Substitute Binary Requires A Variable", "[Substitute]")
+{
+    // even when there is nothing to substitute
+    Oasis::Add<> before { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } };
+    REQUIRE_THROWS_AS(before.Substitute(Oasis::Real { 1.0 }, Oasis::Real { 2.0 }), std::invalid_argument);
+}
+
+TEST_CASE("Substitute Many Variables", "[Substitute]")
+{
+    // x * y + (z - 1)
+    const Oasis::Add<> before {
+        Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Variable { "y" } },
+        Oasis::Subtract { Oasis::Variable { "z" }, Oasis::Real { 1.0 } }
+    };
+
+    const Oasis::Real two { 2.0 };
+    const Oasis::Real three { 3.0 };
+    const std::unordered_map<std::string, const Oasis::Expression*> values { { "x", &two }, { "y", &three } };
+
+    // the result is not simplified, and the subtree without x or y is shared
+    const auto after = Oasis::Substitute(before, values);
+    const Oasis::Add<> expected {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Real { 3.0 } },
+        Oasis::Subtract { Oasis::Variable { "z" }, Oasis::Real { 1.0 } }
+    };
+
+    REQUIRE(after->Equals(expected));
+
+    const auto& afterAdd = static_cast<const Oasis::Add<>&>(*after);
+    REQUIRE((afterAdd.GetLeastSigOpPtr() == before.GetLeastSigOpPtr() || afterAdd.GetMostSigOpPtr() == before.GetLeastSigOpPtr()));
+
+    // an expression without any of the variables is unchanged
+    const auto unchanged = Oasis::Substitute(before.GetLeastSigOp(), values);
+    REQUIRE(unchanged->Equals(before.GetLeastSigOp()));
+
+    Oasis::SimplifyVisitor visitor {};
+    const auto simplified = Oasis::Substitute(before, values, visitor);
+    const Oasis::Add<> simplifiedExpected { Oasis::Variable { "z" }, Oasis::Real { 5.0 } };
+
+    REQUIRE(simplified->Equals(simplifiedExpected));
+}
+
+TEST_CASE("Copy shares operands", "[TreeManip]")
+{
+    Oasis::Add<Oasis::Expression> add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Real { 3.0 }
+    };
+
+    auto copy = add.Copy();
+    const auto& copiedAdd = static_cast<const Oasis::Add<Oasis::Expression>&>(*copy);
+
+    REQUIRE(copiedAdd.mostSigOp == add.mostSigOp);
+    REQUIRE(copiedAdd.leastSigOp == add.leastSigOp);
+
+    auto generalized = add.Generalize();
+    const auto& generalizedAdd = static_cast<const Oasis::Add<Oasis::Expression>&>(*generalized);
+    REQUIRE(generalizedAdd.mostSigOp == add.mostSigOp);
+
+    Oasis::Add<Oasis::Expression> rebuilt;
+    rebuilt.SetMostSigOp(add.leastSigOp);
+    rebuilt.SetLeastSigOp(add.mostSigOp);
+    REQUIRE(rebuilt.mostSigOp == add.leastSigOp);
+    REQUIRE(rebuilt.Equals(add));
+}
+
+TEST_CASE("Hash follows associativity and commutativity", "[Hash]")
+{
+    Oasis::Add add1 {
+        Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } },
+        Oasis::Real { 3.0 }
+    };
+
+    Oasis::Add add2 {
+        Oasis::Real { 3.0 },
+        Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }
+    };
+
+    REQUIRE(add1.Hash() == add2.Hash());
+    REQUIRE(add1.Hash() == add1.Generalize()->Hash());
+    REQUIRE(add1.Hash() == add1.Copy()->Hash());
+
+    // (x + x) + y != (x + y) + y
+    Oasis::Add twoX { Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "x" } }, Oasis::Variable { "y" } };
+    Oasis::Add twoY { Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "y" } }, Oasis::Variable { "y" } };
+    REQUIRE(twoX.Hash() != twoY.Hash());
+    REQUIRE_FALSE(twoX.Equals(twoY));
+
+    Oasis::Subtract subtract1 { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    Oasis::Subtract subtract2 { Oasis::Real { 1.0 }, Oasis::Variable { "x" } };
+    REQUIRE(subtract1.Hash() != subtract2.Hash());
+
+    Oasis::Subtract<Oasis::Variable, Oasis::Real> specialized { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    REQUIRE(specialized.Hash() == subtract1.Hash());
+}
+
+TEST_CASE("Expressions as unordered_map keys", "[Hash]")
+{
+    std::unordered_map<std::unique_ptr<Oasis::Expression>, int, Oasis::ExpressionHash, Oasis::ExpressionEqual> counts;
+
+    Oasis::Multiply xy { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    Oasis::Multiply yx { Oasis::Variable { "y" }, Oasis::Variable { "x" } };
+
+    counts[xy.Copy()]++;
+    counts[yx.Copy()]++;
+    counts[Oasis::Variable { "x" }.Copy()]++;
+
+    REQUIRE(counts.size() == 2);
+    REQUIRE(counts.find(xy.Copy()) != counts.end());
+    REQUIRE(counts.find(xy.Copy())->second == 2);
+}
@@ -0,0 +1,109 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <compare>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/CanonicalOrder.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Canonical order is consistent with Equals", "[CanonicalOrder]")
+{
+    Oasis::Add<> lhs {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Real { 1.0 },
+        Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }
+    };
+
+    Oasis::Add<> rhs {
+        Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } },
+        Oasis::Add { Oasis::Real { 1.0 }, Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } }
+    };
+
+    REQUIRE(lhs.Equals(rhs));
+    REQUIRE(std::is_eq(Oasis::CanonicalCompare(lhs, rhs)));
+
+    // leaves are ordered by type, then by payload
+    REQUIRE(std::is_lt(Oasis::CanonicalCompare(Oasis::Real { 1.0 }, Oasis::Real { 2.0 })));
+    REQUIRE(std::is_eq(Oasis::CanonicalCompare(Oasis::Real { 0.0 }, Oasis::Real { -0.0 })));
+    REQUIRE(std::is_gt(Oasis::CanonicalCompare(Oasis::Variable { "y" }, Oasis::Variable { "x" })));
+    REQUIRE(std::is_lt(Oasis::CanonicalCompare(Oasis::Real { 5.0 }, Oasis::Variable { "x" })));
+
+    // non-commutative operands keep their order
+    Oasis::Subtract<> xMinusY { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    Oasis::Subtract<> yMinusX { Oasis::Variable { "y" }, Oasis::Variable { "x" } };
+    REQUIRE(std::is_lt(Oasis::CanonicalCompare(xMinusY, yMinusX)));
+}
+
+TEST_CASE("Equals tracks the multiplicity of operands", "[CanonicalOrder]")
+{
+    // x + x + y and x + y + y hold the same distinct operands
+    Oasis::Add<> lhs { Oasis::Variable { "x" }, Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    Oasis::Add<> rhs { Oasis::Variable { "x" }, Oasis::Variable { "y" }, Oasis::Variable { "y" } };
+
+    REQUIRE_FALSE(lhs.Equals(rhs));
+    REQUIRE_FALSE(rhs.Equals(lhs));
+    REQUIRE(std::is_neq(Oasis::CanonicalCompare(lhs, rhs)));
+}
+
+TEST_CASE("Canonicalize sorts sums and products", "[CanonicalOrder]")
+{
+    Oasis::Add<> expression {
+        Oasis::Variable { "y" },
+        Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Real { 3.0 } },
+        Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } }
+    };
+
+    auto canonical = Oasis::Canonicalize(expression);
+    REQUIRE(canonical->Equals(expression));
+
+    const auto& canonicalAdd = static_cast<const Oasis::Add<>&>(*canonical);
+    const std::vector<const Oasis::Expression*> operands = canonicalAdd.FlattenView();
+
+    REQUIRE(operands.size() == 4);
+    REQUIRE(operands[0]->Equals(Oasis::Real { 1.0 }));
+    REQUIRE(operands[1]->Equals(Oasis::Variable { "x" }));
+    REQUIRE(operands[2]->Equals(Oasis::Variable { "y" }));
+
+    // 3 * x, with its factors sorted
+    REQUIRE(operands[3]->Is<Oasis::Multiply>());
+    REQUIRE(operands[3]->GetOperandAt(0)->Equals(Oasis::Real { 3.0 }));
+
+    // expressions that are equal have structurally equivalent canonical forms
+    Oasis::Add<> reordered {
+        Oasis::Variable { "x" },
+        Oasis::Real { 1.0 },
+        Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Variable { "x" } },
+        Oasis::Variable { "y" }
+    };
+
+    auto reorderedCanonical = Oasis::Canonicalize(reordered);
+    REQUIRE(reorderedCanonical->StructurallyEquivalent(*canonical));
+    REQUIRE(std::is_eq(Oasis::CanonicalCompare(*reorderedCanonical, *canonical)));
+}
+
+TEST_CASE("Integrals keep the order of their operands", "[CanonicalOrder]")
+{
+    // the integrand and the variable of integration are not interchangeable
+    Oasis::Integral<> ofXdY { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    Oasis::Integral<> ofYdX { Oasis::Variable { "y" }, Oasis::Variable { "x" } };
+
+    REQUIRE_FALSE(ofXdY.Equals(ofYdX));
+    REQUIRE(std::is_neq(Oasis::CanonicalCompare(ofXdY, ofYdX)));
+    REQUIRE(ofXdY.Hash() != ofYdX.Hash());
+
+    // canonicalizing leaves the order alone, so equal integrals still have equivalent canonical forms
+    auto canonical = Oasis::Canonicalize(ofXdY);
+    REQUIRE(canonical->StructurallyEquivalent(ofXdY));
+    REQUIRE(std::is_eq(Oasis::CanonicalCompare(*canonical, ofXdY)));
+    REQUIRE_FALSE(canonical->Equals(ofYdX));
+}
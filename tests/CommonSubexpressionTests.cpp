@@ -0,0 +1,56 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/CommonSubexpression.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Common Subexpressions Are Shared", "[CommonSubexpression]")
+{
+    // (x + 1)^2 * sin(x + 1) - (x + 1)^2
+    const auto xPlusOne = [] { return Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }; };
+    const auto square = [&xPlusOne] { return Oasis::Exponent { xPlusOne(), Oasis::Real { 2.0 } }; };
+    const Oasis::Subtract<> expression {
+        Oasis::Multiply { square(), Oasis::Sine<Oasis::Expression> { xPlusOne() } },
+        square()
+    };
+
+    // -, *, and two copies of ^, +, x, 1, 2, and sin, +, x, 1
+    REQUIRE(Oasis::CountDistinctNodes(expression) == 16);
+
+    const auto shared = Oasis::EliminateCommonSubexpressions(expression);
+    REQUIRE(shared->Equals(expression));
+    REQUIRE(shared->StructurallyEquivalent(expression));
+
+    // -, *, ^, +, x, 1, 2, sin
+    REQUIRE(Oasis::CountDistinctNodes(*shared) == 8);
+
+    const Oasis::Expression* product = shared->GetOperandAt(0);
+    REQUIRE(product->GetOperandAt(0) == shared->GetOperandAt(1));
+    REQUIRE(product->GetOperandAt(1)->GetOperandAt(0) == product->GetOperandAt(0)->GetOperandAt(0));
+}
+
+TEST_CASE("Common Subexpressions Keep Operand Order", "[CommonSubexpression]")
+{
+    // (x - y) * (y - x)
+    const Oasis::Multiply<> expression {
+        Oasis::Subtract { Oasis::Variable { "x" }, Oasis::Variable { "y" } },
+        Oasis::Subtract { Oasis::Variable { "y" }, Oasis::Variable { "x" } }
+    };
+
+    const auto shared = Oasis::EliminateCommonSubexpressions(expression);
+    REQUIRE(shared->StructurallyEquivalent(expression));
+
+    // *, both differences, x, y
+    REQUIRE(Oasis::CountDistinctNodes(*shared) == 5);
+    REQUIRE(shared->GetOperandAt(0) != shared->GetOperandAt(1));
+    REQUIRE(shared->GetOperandAt(0)->GetOperandAt(0) == shared->GetOperandAt(1)->GetOperandAt(1));
+}
@@ -0,0 +1,339 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Compile.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Pi.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("Compiled Evaluation", "[Compile]")
+{
+    // |sin(x * pi) - y^2| / log_e(x + 2) + -y
+    const Oasis::Add<> expression {
+        Oasis::Divide {
+            Oasis::Magnitude<Oasis::Expression> { Oasis::Subtract {
+                Oasis::Sine<Oasis::Expression> { Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Pi {} } },
+                Oasis::Exponent { Oasis::Variable { "y" }, Oasis::Real { 2.0 } } } },
+            Oasis::Log { Oasis::EulerNumber {}, Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } } },
+        Oasis::Negate<Oasis::Expression> { Oasis::Variable { "y" } }
+    };
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    REQUIRE(compiled.has_value());
+    REQUIRE(compiled->GetVariableCount() == 2);
+
+    const auto reference = [](double x, double y) {
+        return std::abs(std::sin(x * std::numbers::pi) - y * y) / std::log(x + 2.0) - y;
+    };
+
+    for (const auto [x, y] : { std::array { 0.5, 1.5 }, std::array { 3.0, -2.0 }, std::array { 0.25, 0.0 } }) {
+        const std::array arguments { x, y };
+        REQUIRE_THAT((*compiled)(arguments), WithinRel(reference(x, y), 1e-12));
+
+        std::vector<double> stack(compiled->GetStackSize());
+        REQUIRE_THAT(compiled->Evaluate(arguments, stack), WithinRel(reference(x, y), 1e-12));
+    }
+}
+
+TEST_CASE("Compiled Constant Folding", "[Compile]")
+{
+    // 2^3 * (1 + x) - log_2(8)
+    const Oasis::Subtract<> expression {
+        Oasis::Multiply { Oasis::Exponent { Oasis::Real { 2.0 }, Oasis::Real { 3.0 } }, Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } } },
+        Oasis::Log { Oasis::Real { 2.0 }, Oasis::Real { 8.0 } }
+    };
+
+    const std::array variables { Oasis::Variable { "x" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    REQUIRE(compiled.has_value());
+
+    // 8, 1, x, +, *, 3, -
+    REQUIRE(compiled->GetInstructionCount() == 7);
+    REQUIRE_THAT((*compiled)(std::array { 4.0 }), WithinRel(37.0, 1e-12));
+
+    const auto constant = Oasis::Compile(Oasis::Negate<Oasis::Expression> { Oasis::Add { Oasis::Pi {}, Oasis::Real { 1.0 } } }, {});
+    REQUIRE(constant.has_value());
+    REQUIRE(constant->GetInstructionCount() == 1);
+    REQUIRE_THAT((*constant)({}), WithinRel(-(std::numbers::pi + 1.0), 1e-12));
+}
+
+TEST_CASE("Compiling Unsupported Expressions", "[Compile]")
+{
+    const std::array variables { Oasis::Variable { "x" } };
+
+    REQUIRE_FALSE(Oasis::Compile(Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "y" } }, variables).has_value());
+    REQUIRE_FALSE(Oasis::Compile(Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Imaginary {} }, variables).has_value());
+}
+
+TEST_CASE("Compiled Batch Evaluation", "[Compile]")
+{
+    // -|x - y| * 2 / (x + 3) + x^y
+    const Oasis::Add<> expression {
+        Oasis::Divide {
+            Oasis::Multiply { Oasis::Negate<Oasis::Expression> { Oasis::Magnitude<Oasis::Expression> { Oasis::Subtract { Oasis::Variable { "x" }, Oasis::Variable { "y" } } } }, Oasis::Real { 2.0 } },
+            Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 3.0 } } },
+        Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Variable { "y" } }
+    };
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    REQUIRE(compiled.has_value());
+
+    // sizes that leave remainders for every vector width and span several blocks
+    for (const std::size_t size : { 0, 3, 17, 1000 }) {
+        std::vector<double> xs(size);
+        std::vector<double> ys(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            xs[i] = 0.5 + static_cast<double>(i) * 0.01;
+            ys[i] = 2.0 - static_cast<double>(i % 7) * 0.5;
+        }
+
+        const std::array<std::span<const double>, 2> columns { xs, ys };
+        std::vector<double> out(size);
+        compiled->EvaluateBatch(columns, out);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            REQUIRE_THAT(out[i], WithinRel((*compiled)(std::array { xs[i], ys[i] }), 1e-12));
+        }
+    }
+
+    std::vector<double> shortColumn(2);
+    std::vector<double> out(3);
+    REQUIRE_THROWS_AS(compiled->EvaluateBatch(std::array<std::span<const double>, 2> { shortColumn, shortColumn }, out), std::invalid_argument);
+    REQUIRE_THROWS_AS(compiled->EvaluateBatch(std::array<std::span<const double>, 1> { shortColumn }, std::span<double> {}), std::invalid_argument);
+}
+
+TEST_CASE("Compiled Gradient", "[Compile]")
+{
+    // x^3 * sin(y) / log_2(x + y) + 2^x - |x - y|
+    const Oasis::Subtract<> expression {
+        Oasis::Add {
+            Oasis::Divide {
+                Oasis::Multiply { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 3.0 } }, Oasis::Sine<Oasis::Expression> { Oasis::Variable { "y" } } },
+                Oasis::Log { Oasis::Real { 2.0 }, Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "y" } } } },
+            Oasis::Exponent { Oasis::Real { 2.0 }, Oasis::Variable { "x" } } },
+        Oasis::Magnitude<Oasis::Expression> { Oasis::Subtract { Oasis::Variable { "x" }, Oasis::Variable { "y" } } }
+    };
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    REQUIRE(compiled.has_value());
+
+    // the power rule holds for negative bases, where the general rule would take log(x)
+    for (const auto [x, y] : { std::array { 1.5, 2.0 }, std::array { -0.5, 3.0 }, std::array { 4.0, 0.25 } }) {
+        const double log2 = std::log(2.0);
+        const double l = std::log(x + y) / log2;
+        const double sign = x > y ? 1.0 : -1.0;
+
+        const double dx = 3.0 * x * x * std::sin(y) / l - x * x * x * std::sin(y) / (l * l * (x + y) * log2) + std::pow(2.0, x) * log2 - sign;
+        const double dy = x * x * x * std::cos(y) / l - x * x * x * std::sin(y) / (l * l * (x + y) * log2) + sign;
+
+        std::array<double, 2> gradient {};
+        const double value = compiled->EvaluateGradient(std::array { x, y }, gradient);
+
+        REQUIRE_THAT(value, WithinRel((*compiled)(std::array { x, y }), 1e-12));
+        REQUIRE_THAT(gradient[0], WithinRel(dx, 1e-12));
+        REQUIRE_THAT(gradient[1], WithinRel(dy, 1e-12));
+    }
+
+    std::array<double, 1> tooShort {};
+    REQUIRE_THROWS_AS(compiled->EvaluateGradient(std::array { 1.0, 2.0 }, tooShort), std::invalid_argument);
+}
+
+TEST_CASE("Reverse Mode Gradient", "[Compile]")
+{
+    // sum of (w_i * x_i - 1)^2 for 300 weights w_i, with x_i = i / 100
+    constexpr std::size_t weightCount = 300;
+
+    std::vector<Oasis::Variable> variables;
+    std::vector<std::unique_ptr<Oasis::Expression>> terms;
+    for (std::size_t i = 0; i < weightCount; ++i) {
+        variables.emplace_back("w" + std::to_string(i));
+        terms.push_back(std::make_unique<Oasis::Exponent<>>(
+            Oasis::Subtract { Oasis::Multiply { variables.back(), Oasis::Real { static_cast<double>(i) / 100.0 } }, Oasis::Real { 1.0 } },
+            Oasis::Real { 2.0 }));
+    }
+
+    const auto loss = Oasis::BuildFromVector<Oasis::Add>(std::move(terms));
+
+    std::vector<double> weights(weightCount);
+    for (std::size_t i = 0; i < weightCount; ++i) {
+        weights[i] = 1.0 - static_cast<double>(i % 5) * 0.5;
+    }
+
+    const auto gradient = Oasis::Gradient(*loss, variables, weights);
+    REQUIRE(gradient.has_value());
+    REQUIRE(gradient->size() == weightCount);
+
+    for (std::size_t i = 0; i < weightCount; ++i) {
+        const double x = static_cast<double>(i) / 100.0;
+        REQUIRE_THAT((*gradient)[i], WithinAbs(2.0 * (weights[i] * x - 1.0) * x, 1e-12));
+    }
+
+    REQUIRE_FALSE(Oasis::Gradient(*loss, variables, std::span { weights }.first(2)).has_value());
+    REQUIRE_FALSE(Oasis::Gradient(Oasis::Imaginary {}, {}, {}).has_value());
+}
+
+TEST_CASE("Reverse Mode Agrees With Forward Mode", "[Compile]")
+{
+    // log_x(y + 3) * sin(x * y) / (|x| + 1) - 3^y * x^2
+    const Oasis::Subtract<> expression {
+        Oasis::Divide {
+            Oasis::Multiply {
+                Oasis::Log { Oasis::Variable { "x" }, Oasis::Add { Oasis::Variable { "y" }, Oasis::Real { 3.0 } } },
+                Oasis::Sine<Oasis::Expression> { Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Variable { "y" } } } },
+            Oasis::Add { Oasis::Magnitude<Oasis::Expression> { Oasis::Variable { "x" } }, Oasis::Real { 1.0 } } },
+        Oasis::Multiply {
+            Oasis::Exponent { Oasis::Real { 3.0 }, Oasis::Variable { "y" } },
+            Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } }
+    };
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    REQUIRE(compiled.has_value());
+
+    for (const auto arguments : { std::array { 2.0, 1.0 }, std::array { 0.5, -1.5 }, std::array { 5.0, 0.0 } }) {
+        std::array<double, 2> forward {};
+        std::array<double, 2> reverse {};
+
+        REQUIRE_THAT(compiled->EvaluateAdjoint(arguments, reverse), WithinRel(compiled->EvaluateGradient(arguments, forward), 1e-12));
+        REQUIRE_THAT(reverse[0], WithinRel(forward[0], 1e-12));
+        REQUIRE_THAT(reverse[1], WithinRel(forward[1], 1e-12));
+    }
+}
+
+TEST_CASE("Interval Evaluation Encloses Values", "[Compile]")
+{
+    // log_x(y + 3) * sin(x * y) / (|x| + 1) - 3^y * x^2
+    const Oasis::Subtract<> expression {
+        Oasis::Divide {
+            Oasis::Multiply {
+                Oasis::Log { Oasis::Variable { "x" }, Oasis::Add { Oasis::Variable { "y" }, Oasis::Real { 3.0 } } },
+                Oasis::Sine<Oasis::Expression> { Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Variable { "y" } } } },
+            Oasis::Add { Oasis::Magnitude<Oasis::Expression> { Oasis::Variable { "x" } }, Oasis::Real { 1.0 } } },
+        Oasis::Multiply {
+            Oasis::Exponent { Oasis::Real { 3.0 }, Oasis::Variable { "y" } },
+            Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } }
+    };
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    REQUIRE(compiled.has_value());
+
+    const std::vector<Oasis::Interval> xs { { 2.0, 2.5 }, { 0.25, 0.75 }, { 1.5, 4.0 }, { 5.0, 5.0 } };
+    const std::vector<Oasis::Interval> ys { { 1.0, 1.25 }, { -1.5, -0.5 }, { -2.0, 2.0 }, { 0.0, 0.0 } };
+
+    std::vector<Oasis::Interval> bounds(xs.size());
+    compiled->EvaluateIntervalBatch(std::array<std::span<const Oasis::Interval>, 2> { xs, ys }, bounds);
+
+    constexpr int STEPS = 20;
+    for (std::size_t box = 0; box < xs.size(); ++box) {
+        const auto single = compiled->EvaluateInterval(std::array { xs[box], ys[box] });
+        REQUIRE(single.lower == bounds[box].lower);
+        REQUIRE(single.upper == bounds[box].upper);
+
+        for (int i = 0; i <= STEPS; ++i) {
+            for (int j = 0; j <= STEPS; ++j) {
+                const double x = xs[box].lower + (xs[box].upper - xs[box].lower) * i / STEPS;
+                const double y = ys[box].lower + (ys[box].upper - ys[box].lower) * j / STEPS;
+                REQUIRE(bounds[box].Contains((*compiled)(std::array { x, y })));
+            }
+        }
+    }
+
+    REQUIRE_THROWS_AS(compiled->EvaluateInterval(std::array { xs[0] }), std::invalid_argument);
+}
+
+TEST_CASE("Interval Evaluation On Monotonic Segments", "[Compile]")
+{
+    const std::array variables { Oasis::Variable { "x" } };
+    const auto bound = [&variables](const Oasis::Expression& expression, Oasis::Interval x) {
+        return Oasis::Compile(expression, variables)->EvaluateInterval(std::array { x });
+    };
+
+    // Sine reaches its maximum inside [0, pi], and is monotonic on [0.1, 0.2].
+    const Oasis::Sine<Oasis::Expression> sine { variables[0] };
+    const auto peak = bound(sine, { 0.0, std::numbers::pi });
+    REQUIRE(peak.upper == 1.0);
+    REQUIRE_THAT(peak.lower, WithinAbs(0.0, 1e-15));
+
+    const auto segment = bound(sine, { 0.1, 0.2 });
+    REQUIRE_THAT(segment.lower, WithinAbs(std::sin(0.1), 1e-15));
+    REQUIRE_THAT(segment.upper, WithinAbs(std::sin(0.2), 1e-15));
+    REQUIRE(bound(sine, { -10.0, 10.0 }).lower == -1.0);
+
+    // Even powers reach zero inside the interval, odd powers are increasing.
+    const auto square = bound(Oasis::Exponent { variables[0], Oasis::Real { 2.0 } }, { -1.0, 2.0 });
+    REQUIRE(square.lower == 0.0);
+    REQUIRE_THAT(square.upper, WithinAbs(4.0, 1e-15));
+
+    const auto cube = bound(Oasis::Exponent { variables[0], Oasis::Real { 3.0 } }, { -2.0, 1.0 });
+    REQUIRE_THAT(cube.lower, WithinAbs(-8.0, 1e-14));
+    REQUIRE_THAT(cube.upper, WithinAbs(1.0, 1e-15));
+
+    // The logarithm is unbounded below toward zero, and a quotient by an interval containing zero is unbounded.
+    const auto logarithm = bound(Oasis::Log { Oasis::EulerNumber {}, variables[0] }, { 0.0, std::numbers::e });
+    REQUIRE(logarithm.lower == -std::numeric_limits<double>::infinity());
+    REQUIRE_THAT(logarithm.upper, WithinAbs(1.0, 1e-15));
+
+    const auto reciprocal = bound(Oasis::Divide { Oasis::Real { 1.0 }, variables[0] }, { -1.0, 1.0 });
+    REQUIRE(reciprocal.lower == -std::numeric_limits<double>::infinity());
+    REQUIRE(reciprocal.upper == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Interval Evaluation Of Folded Constants", "[Compile]")
+{
+    // (1e16 + 1) - 1e16 folds to 0 when rounded to nearest, but its bound must still contain 1.
+    const Oasis::Subtract<> cancellation {
+        Oasis::Add { Oasis::Real { 1e16 }, Oasis::Real { 1.0 } },
+        Oasis::Real { 1e16 }
+    };
+
+    const auto compiled = Oasis::Compile(cancellation, {});
+    REQUIRE(compiled.has_value());
+    REQUIRE(compiled->GetInstructionCount() == 1);
+
+    const auto bound = compiled->EvaluateInterval({});
+    REQUIRE(bound.Contains(1.0));
+
+    std::vector<Oasis::Interval> bounds(3);
+    compiled->EvaluateIntervalBatch({}, bounds);
+    for (const auto& batched : bounds) {
+        REQUIRE(batched.lower == bound.lower);
+        REQUIRE(batched.upper == bound.upper);
+    }
+
+    // Bounds of irrational constants contain their exact values.
+    const auto pi = Oasis::Compile(Oasis::Pi {}, {})->EvaluateInterval({});
+    REQUIRE(pi.lower < std::numbers::pi);
+    REQUIRE(pi.upper > std::numbers::pi);
+}
@@ -1,7 +1,11 @@
 //
 // Created by bachia on 4/5/2024.
 //
+#include <array>
+#include <cmath>
+
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include "Oasis/Add.hpp"
 #include "Oasis/Divide.hpp"
@@ -15,6 +19,11 @@
 #include "Oasis/EulerNumber.hpp"
 #include "Oasis/SimplifyVisitor.hpp"
 
+#include "Oasis/Compile.hpp"
+#include "Oasis/DifferentiateVisitor.hpp"
+#include "Oasis/Magnitude.hpp"
+#include "Oasis/Sine.hpp"
+
 inline Oasis::SimplifyVisitor simplifyVisitor{};
 
 TEST_CASE("Differentiate Nonzero number", "[Differentiate][Real][Nonzero]")
@@ -359,4 +368,81 @@ TEST_CASE("Expression Base Exponential Derivative", "[Derivative][Exponent]")
 
     auto simplified = diffExp.Accept(simplifyVisitor).value();
     REQUIRE(simplified->Equals(expected));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Higher Order Derivative", "[Derivative][Divide][Product]")
+{
+    // d^4/dx^4 ((x^2 + 1) * (x^3 + x) / (x + 2))
+    Oasis::Divide quotient { Oasis::Multiply { Oasis::Add { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }, Oasis::Real { 1.0 } },
+                                 Oasis::Add { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 3.0 } }, Oasis::Variable { "x" } } },
+        Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } };
+    Oasis::Derivative fourth { Oasis::Derivative { Oasis::Derivative { Oasis::Derivative { quotient, Oasis::Variable { "x" } },
+                                                       Oasis::Variable { "x" } },
+                                   Oasis::Variable { "x" } },
+        Oasis::Variable { "x" } };
+
+    auto simplified = fourth.Accept(simplifyVisitor).value();
+
+    const std::array variables { Oasis::Variable { "x" } };
+    const auto compiled = Oasis::Compile(*simplified, variables);
+    REQUIRE(compiled.has_value());
+
+    for (const auto [x, expected] : { std::array { -1.0, -1176.0 }, std::array { 0.5, 1464.0 / 125.0 }, std::array { 3.0, 2952.0 / 125.0 } }) {
+        REQUIRE_THAT((*compiled)(std::array { x }), Catch::Matchers::WithinRel(expected, 1e-9));
+    }
+}
+
+TEST_CASE("Differentiate Visitor", "[Differentiate][DifferentiateVisitor]")
+{
+    // d/dx (log_x(y + 3) * |x - y| + y^x)
+    Oasis::Add expression {
+        Oasis::Multiply { Oasis::Log { Oasis::Variable { "x" }, Oasis::Add { Oasis::Variable { "y" }, Oasis::Real { 3.0 } } },
+            Oasis::Magnitude<Oasis::Expression> { Oasis::Subtract { Oasis::Variable { "x" }, Oasis::Variable { "y" } } } },
+        Oasis::Exponent { Oasis::Variable { "y" }, Oasis::Variable { "x" } }
+    };
+
+    Oasis::DifferentiateVisitor differentiateVisitor { Oasis::Variable { "x" } };
+    auto derivative = expression.Accept(differentiateVisitor);
+    REQUIRE(derivative.has_value());
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(expression, variables);
+    const auto compiledDerivative = Oasis::Compile(*derivative.value(), variables);
+    REQUIRE(compiled.has_value());
+    REQUIRE(compiledDerivative.has_value());
+
+    for (const auto arguments : { std::array { 2.0, 0.5 }, std::array { 0.5, 4.0 } }) {
+        std::array<double, 2> gradient {};
+        compiled->EvaluateGradient(arguments, gradient);
+        REQUIRE_THAT((*compiledDerivative)(arguments), Catch::Matchers::WithinRel(gradient[0], 1e-12));
+    }
+
+    // constants differentiate to zero without building any terms
+    auto constant = Oasis::Multiply { Oasis::Variable { "y" }, Oasis::Real { 2.0 } }.Accept(differentiateVisitor);
+    REQUIRE(constant.has_value());
+    REQUIRE(constant.value()->Equals(Oasis::Real { 0.0 }));
+
+    // d/dx sin(x^2) = 2x cos(x^2)
+    auto sine = Oasis::Sine<Oasis::Expression> { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } }.Accept(differentiateVisitor);
+    REQUIRE(sine.has_value());
+    const auto compiledSine = Oasis::Compile(*sine.value(), variables);
+    REQUIRE(compiledSine.has_value());
+    REQUIRE_THAT((*compiledSine)(std::array { 1.5, 0.0 }), Catch::Matchers::WithinRel(3.0 * std::cos(2.25), 1e-12));
+}
+
+TEST_CASE("Differentiate Visitor Mixed Partial", "[Differentiate][DifferentiateVisitor]")
+{
+    // d/dy d/dx (x^2 y^3) = 6xy^2
+    Oasis::Derivative mixed {
+        Oasis::Derivative { Oasis::Multiply { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }, Oasis::Exponent { Oasis::Variable { "y" }, Oasis::Real { 3.0 } } },
+            Oasis::Variable { "x" } },
+        Oasis::Variable { "y" }
+    };
+
+    auto simplified = mixed.Accept(simplifyVisitor).value();
+
+    const std::array variables { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto compiled = Oasis::Compile(*simplified, variables);
+    REQUIRE(compiled.has_value());
+    REQUIRE_THAT((*compiled)(std::array { 2.0, 3.0 }), Catch::Matchers::WithinRel(108.0, 1e-12));
+}
@@ -0,0 +1,95 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/ExpressionCache.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/SimplifyVisitor.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Cache lookups match identical trees", "[ExpressionCache]")
+{
+    Oasis::ExpressionCache<int> cache { 4 };
+
+    cache.Insert(Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }, 1);
+
+    // the key is copied, so any identical tree hits
+    const int* hit = cache.Find(Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } });
+    REQUIRE(hit != nullptr);
+    REQUIRE(*hit == 1);
+
+    REQUIRE(cache.Find(Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }) == nullptr);
+
+    // commuted operands are a distinct key
+    REQUIRE(cache.Find(Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } }) == nullptr);
+
+    cache.Insert(Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }, 2);
+    REQUIRE(cache.Size() == 1);
+    REQUIRE(*cache.Find(Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }) == 2);
+}
+
+TEST_CASE("Cache evicts the least recently used entry", "[ExpressionCache]")
+{
+    Oasis::ExpressionCache<int> cache { 2 };
+
+    cache.Insert(Oasis::Variable { "x" }, 1);
+    cache.Insert(Oasis::Variable { "y" }, 2);
+
+    // touching x makes y the least recently used
+    REQUIRE(cache.Find(Oasis::Variable { "x" }) != nullptr);
+
+    cache.Insert(Oasis::Variable { "z" }, 3);
+
+    REQUIRE(cache.Size() == 2);
+    REQUIRE(cache.Find(Oasis::Variable { "y" }) == nullptr);
+    REQUIRE(*cache.Find(Oasis::Variable { "x" }) == 1);
+    REQUIRE(*cache.Find(Oasis::Variable { "z" }) == 3);
+
+    cache.Clear();
+    REQUIRE(cache.Size() == 0);
+    REQUIRE(cache.Find(Oasis::Variable { "x" }) == nullptr);
+}
+
+TEST_CASE("Memoized simplification", "[ExpressionCache]")
+{
+    // (2x + 3x) * (2x + 3x) repeats its factor
+    Oasis::Add<> factor {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Variable { "x" } }
+    };
+    Oasis::Multiply<> expression { factor, factor };
+
+    Oasis::SimplifyVisitor plain {};
+    auto expected = expression.Accept(plain);
+    REQUIRE(expected.has_value());
+    REQUIRE(plain.GetMemoSize() == 0);
+
+    Oasis::SimplifyOpts opts { .memoCapacity = 64 };
+    Oasis::SimplifyVisitor memoized { opts };
+
+    auto first = expression.Accept(memoized);
+    REQUIRE(first.has_value());
+    REQUIRE(first.value()->Equals(*expected.value()));
+
+    const std::size_t cached = memoized.GetMemoSize();
+    REQUIRE(cached > 0);
+    REQUIRE(cached <= opts.memoCapacity);
+
+    // simplifying again is a lookup and learns nothing new
+    auto second = expression.Accept(memoized);
+    REQUIRE(second.has_value());
+    REQUIRE(second.value()->Equals(*expected.value()));
+    REQUIRE(memoized.GetMemoSize() == cached);
+
+    Oasis::SimplifyOpts tinyOpts { .memoCapacity = 1 };
+    Oasis::SimplifyVisitor tiny { tinyOpts };
+
+    auto bounded = expression.Accept(tiny);
+    REQUIRE(bounded.has_value());
+    REQUIRE(bounded.value()->Equals(*expected.value()));
+    REQUIRE(tiny.GetMemoSize() == 1);
+}
@@ -0,0 +1,109 @@
+//
+// Created by agent on 10/17/26.
+//
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/CanonicalOrder.hpp"
+#include "Oasis/ExpressionPool.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Identical expressions intern to the same node", "[ExpressionPool]")
+{
+    Oasis::ExpressionPool pool;
+
+    Oasis::Add first {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Negate { Oasis::Variable { "y" } }
+    };
+
+    Oasis::Add second {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Negate { Oasis::Variable { "y" } }
+    };
+
+    auto internedFirst = pool.Intern(first);
+    auto internedSecond = pool.Intern(second);
+
+    REQUIRE(internedFirst != nullptr);
+    REQUIRE(internedFirst == internedSecond);
+    REQUIRE(internedFirst->Equals(first));
+}
+
+TEST_CASE("Distinct expressions intern to distinct nodes", "[ExpressionPool]")
+{
+    Oasis::ExpressionPool pool;
+
+    auto x = pool.Intern(Oasis::Variable { "x" });
+    auto y = pool.Intern(Oasis::Variable { "y" });
+    auto one = pool.Intern(Oasis::Real { 1.0 });
+    auto two = pool.Intern(Oasis::Real { 2.0 });
+
+    REQUIRE(x != y);
+    REQUIRE(one != two);
+    REQUIRE(x == pool.Intern(Oasis::Variable { "x" }));
+    REQUIRE(one == pool.Intern(Oasis::Real { 1.0 }));
+
+    // interning is structural, so operand order matters
+    auto xPlusY = pool.Intern(Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "y" } });
+    auto yPlusX = pool.Intern(Oasis::Add { Oasis::Variable { "y" }, Oasis::Variable { "x" } });
+    REQUIRE(xPlusY != yPlusX);
+    REQUIRE(xPlusY->Equals(*yPlusX));
+
+    // and so does their grouping
+    auto grouped = pool.Intern(Oasis::Add { Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "y" } }, Oasis::Variable { "z" } });
+    auto regrouped = pool.Intern(Oasis::Add { Oasis::Variable { "x" }, Oasis::Add { Oasis::Variable { "y" }, Oasis::Variable { "z" } } });
+    REQUIRE(grouped != regrouped);
+    REQUIRE(grouped->Equals(*regrouped));
+
+    // canonical forms of equal expressions intern to the same node
+    REQUIRE(pool.Intern(*Oasis::Canonicalize(*xPlusY)) == pool.Intern(*Oasis::Canonicalize(*yPlusX)));
+    REQUIRE(pool.Intern(*Oasis::Canonicalize(*grouped)) == pool.Intern(*Oasis::Canonicalize(*regrouped)));
+}
+
+TEST_CASE("Shared subexpressions are stored once", "[ExpressionPool]")
+{
+    Oasis::ExpressionPool pool;
+
+    Oasis::Add sum { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    Oasis::Multiply product { sum, sum };
+
+    auto interned = pool.Intern(product);
+
+    // x, 1, x + 1, and (x + 1) * (x + 1)
+    REQUIRE(pool.Size() == 4);
+    REQUIRE(pool.Intern(product) == interned);
+
+    // the canonical product shares the canonical sum as both of its operands
+    const auto internedSum = pool.Intern(sum);
+    const auto& internedProduct = static_cast<const Oasis::Multiply<Oasis::Expression>&>(*interned);
+    REQUIRE(internedProduct.mostSigOp == internedSum);
+    REQUIRE(internedProduct.leastSigOp == internedSum);
+    REQUIRE(pool.Size() == 4);
+
+    pool.Clear();
+    REQUIRE(pool.Size() == 0);
+    REQUIRE(interned->Equals(product));
+}
+
+TEST_CASE("Shared inputs are interned once per node", "[ExpressionPool]")
+{
+    Oasis::ExpressionPool pool;
+
+    // s_k = s_{k-1} + s_{k-1}, where both operands are the same node, has 2^64 paths but 65 nodes
+    std::shared_ptr<const Oasis::Expression> node = std::make_shared<Oasis::Variable>("x");
+    for (int i = 0; i < 64; ++i) {
+        auto sum = std::make_shared<Oasis::Add<>>();
+        sum->SetMostSigOp(node);
+        sum->SetLeastSigOp(node);
+        node = std::move(sum);
+    }
+
+    const auto interned = pool.Intern(*node);
+    REQUIRE(interned != nullptr);
+    REQUIRE(pool.Size() == 65);
+}
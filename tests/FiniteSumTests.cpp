@@ -0,0 +1,87 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Compile.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/FiniteSum.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Variable.hpp"
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("Summation Of Polynomial In Closed Form", "[FiniteSum]")
+{
+    const Oasis::Variable k { "k" };
+    const Oasis::Exponent summand { k, Oasis::Real { 2.0 } };
+
+    // 10^8 terms would take far longer than this test if summed one by one.
+    const double n = 1e8;
+    const auto result = Oasis::EvaluateSummation(summand, k, Oasis::Real { 1.0 }, Oasis::Real { n });
+    REQUIRE(result.has_value());
+    REQUIRE_THAT(*result, WithinRel(n * (n + 1) * (2 * n + 1) / 6, 1e-14));
+
+    // 3k + 2 summed from 10^12 to 10^12 + 9
+    const Oasis::Add linear { Oasis::Multiply { Oasis::Real { 3.0 }, k }, Oasis::Real { 2.0 } };
+    const auto shifted = Oasis::EvaluateSummation(linear, k, Oasis::Real { 1e12 }, Oasis::Real { 1e12 + 9.0 });
+    REQUIRE(shifted.has_value());
+    REQUIRE(*shifted == 3e13 + 155.0);
+
+    const auto empty = Oasis::EvaluateSummation(summand, k, Oasis::Real { 5.0 }, Oasis::Real { 4.0 });
+    REQUIRE(empty.has_value());
+    REQUIRE(*empty == 0.0);
+}
+
+TEST_CASE("Summation Without Closed Form", "[FiniteSum]")
+{
+    const Oasis::Variable k { "k" };
+    const Oasis::Divide summand { Oasis::Real { 1.0 }, Oasis::Exponent { k, Oasis::Real { 2.0 } } };
+
+    // The tail of the sum of 1/k^2 beyond N is 1/N - 1/(2N^2) + 1/(6N^3) - ...
+    const double n = 1e6;
+    const auto result = Oasis::EvaluateSummation(summand, k, Oasis::Real { 1.0 }, Oasis::Real { n });
+    REQUIRE(result.has_value());
+    REQUIRE_THAT(*result, WithinAbs(std::numbers::pi * std::numbers::pi / 6 - 1 / n + 1 / (2 * n * n), 1e-15));
+}
+
+TEST_CASE("Compensated Summation", "[FiniteSum]")
+{
+    const std::array variables { Oasis::Variable { "k" } };
+
+    // 0.1 is not representable, and adding it naively 10^7 times drifts in the tenth digit.
+    const auto constant = Oasis::Compile(Oasis::Real { 0.1 }, variables);
+    REQUIRE(constant.has_value());
+    REQUIRE_THAT(Oasis::CompensatedSum(*constant, 1, 10'000'000), WithinRel(1e6, 1e-15));
+
+    const auto sine = Oasis::Compile(Oasis::Sine<Oasis::Expression> { variables[0] }, variables);
+    REQUIRE(sine.has_value());
+
+    const double serial = Oasis::CompensatedSum(*sine, -1'000'000, 1'000'000, { .threads = 1 });
+    const double parallel = Oasis::CompensatedSum(*sine, -1'000'000, 1'000'000, { .threads = 4 });
+    REQUIRE(parallel == serial);
+    REQUIRE_THAT(serial, WithinAbs(0.0, 1e-9));
+}
+
+TEST_CASE("Summation Errors", "[FiniteSum]")
+{
+    const Oasis::Variable k { "k" };
+    const Oasis::Variable n { "n" };
+
+    REQUIRE(!Oasis::EvaluateSummation(k, k, Oasis::Real { 0.5 }, Oasis::Real { 2.0 }).has_value());
+    REQUIRE(!Oasis::EvaluateSummation(k, k, Oasis::Real { 0.0 }, n).has_value());
+
+    const Oasis::Sine<Oasis::Expression> summand { Oasis::Multiply { k, n } };
+    REQUIRE(!Oasis::EvaluateSummation(summand, k, Oasis::Real { 0.0 }, Oasis::Real { 10.0 }).has_value());
+}
@@ -1,9 +1,17 @@
 #include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
 
 #include "Oasis/Add.hpp"
+#include "Oasis/Compile.hpp"
 #include "Oasis/Divide.hpp"
 #include "Oasis/EulerNumber.hpp"
 #include "Oasis/Exponent.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/IntegrateVisitor.hpp"
 #include "Oasis/Log.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Real.hpp"
@@ -13,6 +21,8 @@
 
 inline Oasis::SimplifyVisitor simplifyVisitor{};
 
+using Catch::Matchers::WithinRel;
+
 TEST_CASE("Integrate Nonzero number", "[Integrate][Real][Nonzero]")
 {
     Oasis::Add<Oasis::Multiply<Oasis::Real, Oasis::Variable>, Oasis::Variable> integral {
@@ -339,4 +349,88 @@ TEST_CASE("Integration By Parts: Exponent and Logarithm", "[Integrate][Exponent]
 
      integrated = integrand.SwapOperands().Integrate(var);
      REQUIRE((integrated->Equals(*ptr)));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Integrate Visitor Agrees With Integrate", "[Integrate][IntegrateVisitor]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Exponent ex { Oasis::EulerNumber {}, x };
+    const Oasis::Exponent xSquared { x, Oasis::Real { 2.0 } };
+    const Oasis::Log lnX { Oasis::EulerNumber {}, x };
+
+    const std::vector<std::unique_ptr<Oasis::Expression>> integrands = [&] {
+        std::vector<std::unique_ptr<Oasis::Expression>> result;
+        result.emplace_back(Oasis::Real { 2.0 }.Copy());
+        result.emplace_back(x.Copy());
+        result.emplace_back(Oasis::Variable { "y" }.Copy());
+        result.emplace_back(Oasis::Multiply { Oasis::Real { 3.0 }, x }.Copy());
+        result.emplace_back(Oasis::Add { x, Oasis::Real { 2.0 } }.Copy());
+        result.emplace_back(Oasis::Subtract { x, Oasis::Real { 2.0 } }.Copy());
+        result.emplace_back(xSquared.Copy());
+        result.emplace_back(ex.Copy());
+        result.emplace_back(Oasis::Multiply { x, ex }.Copy());
+        result.emplace_back(Oasis::Multiply { xSquared, ex }.Copy());
+        result.emplace_back(Oasis::Multiply { x, lnX }.Copy());
+        result.emplace_back(Oasis::Multiply { xSquared, lnX }.Copy());
+        return result;
+    }();
+
+    // Antiderivatives from integration by parts are factored differently, so they are compared by
+    // value, with C = 0.
+    const std::array variables { x, Oasis::Variable { "y" }, Oasis::Variable { "C" } };
+
+    Oasis::IntegrateVisitor integrateVisitor { x };
+    for (const auto& integrand : integrands) {
+        auto expected = Oasis::Compile(*integrand->Integrate(x), variables);
+        auto integrated = Oasis::Compile(*integrand->Accept(integrateVisitor).value(), variables);
+        REQUIRE(expected.has_value());
+        REQUIRE(integrated.has_value());
+
+        for (const double value : { 0.5, 1.0, 2.5 }) {
+            const std::array arguments { value, 3.0, 0.0 };
+            REQUIRE_THAT((*integrated)(arguments), WithinRel((*expected)(arguments), 1e-12));
+        }
+    }
+
+    REQUIRE(integrateVisitor.GetMemoSize() > 0);
+}
+
+TEST_CASE("Integrate Visitor Linear Arguments", "[Integrate][IntegrateVisitor]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Multiply threeX { Oasis::Real { 3.0 }, x };
+    const Oasis::Exponent integrand { Oasis::EulerNumber {}, threeX };
+
+    Oasis::IntegrateVisitor integrateVisitor { x };
+    auto integrated = integrand.Accept(integrateVisitor).value();
+
+    auto expected = Oasis::Add {
+        Oasis::Divide { Oasis::Exponent { Oasis::EulerNumber {}, threeX }, Oasis::Real { 3.0 } },
+        Oasis::Variable { "C" }
+    }.Accept(simplifyVisitor).value();
+    REQUIRE(integrated->Equals(*expected));
+}
+
+TEST_CASE("Integrate Visitor Leaves Integrals Without Closed Form", "[Integrate][IntegrateVisitor]")
+{
+    const Oasis::Variable x { "x" };
+
+    // e^(x^2) has no elementary antiderivative.
+    const Oasis::Exponent gaussian { Oasis::EulerNumber {}, Oasis::Exponent { x, Oasis::Real { 2.0 } } };
+    Oasis::IntegrateVisitor integrateVisitor { x };
+    auto integrated = gaussian.Accept(integrateVisitor).value();
+    REQUIRE(integrated->Is<Oasis::Integral>());
+    REQUIRE(integrated->Equals(Oasis::Integral { gaussian, x }));
+
+    // x^8 e^x needs integration by parts eight times over.
+    const Oasis::Multiply integrand { Oasis::Exponent { x, Oasis::Real { 8.0 } }, Oasis::Exponent { Oasis::EulerNumber {}, x } };
+    REQUIRE(integrand.Accept(integrateVisitor).value()->Is<Oasis::Integral>());
+
+    Oasis::IntegrateVisitor deepVisitor { x, Oasis::IntegrateOpts { .partsDepth = 8 } };
+    auto deep = integrand.Accept(deepVisitor).value();
+    REQUIRE(deep->Is<Oasis::Add>());
+    REQUIRE(!deep->Equals(Oasis::Integral { integrand, x }));
+
+    Oasis::IntegrateVisitor thriftyVisitor { x, Oasis::IntegrateOpts { .ruleBudget = 4, .partsDepth = 8 } };
+    REQUIRE(integrand.Accept(thriftyVisitor).value()->Is<Oasis::Integral>());
+}
@@ -221,4 +221,29 @@ TEST_CASE("Multiplying Quadratics", "[Multiply]")
     OASIS_CAPTURE_WITH_SERIALIZER(*expected_simpl);
 
     REQUIRE(simplified->Equals(*expected_simpl));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Collecting Powers of a Large Product", "[Multiply]")
+{
+    // x^1 * y^2 * x^3 * y^4 * ... * y^2000
+    constexpr std::size_t factorCount = 2000;
+
+    std::vector<std::unique_ptr<Oasis::Expression>> factors;
+    for (std::size_t i = 0; i < factorCount; ++i) {
+        const Oasis::Variable base { i % 2 == 0 ? "x" : "y" };
+        factors.push_back(std::make_unique<Oasis::Exponent<>>(base, Oasis::Real { static_cast<double>(i + 1) }));
+    }
+
+    const auto product = Oasis::BuildFromVector<Oasis::Multiply>(std::move(factors));
+    const auto simplified = product->Accept(simplifyVisitor).value();
+
+    // 1 + 3 + ... + 1999 and 2 + 4 + ... + 2000
+    const Oasis::Multiply expected {
+        Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 1000000.0 } },
+        Oasis::Exponent { Oasis::Variable { "y" }, Oasis::Real { 1001000.0 } }
+    };
+
+    OASIS_CAPTURE_WITH_SERIALIZER((*simplified));
+
+    REQUIRE(simplified->Equals(expected));
+}
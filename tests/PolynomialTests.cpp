@@ -124,3 +124,31 @@ TEST_CASE("linear polynomial", "[factor]")
         REQUIRE(root->GetLeastSigOp().GetValue() == 1);
     }
 }
+
+TEST_CASE("cubic polynomial with rational roots", "[factor]")
+{
+    // 2x^3 - 9x^2 - 8x + 15 = (x - 1)(x - 5)(2x + 3)
+    Oasis::Add add {
+        Oasis::Add {
+            Oasis::Add {
+                Oasis::Multiply { Oasis::Real(2), Oasis::Exponent { Oasis::Variable("x"), Oasis::Real(3) } },
+                Oasis::Multiply { Oasis::Real(-9), Oasis::Exponent { Oasis::Variable("x"), Oasis::Real(2) } } },
+            Oasis::Multiply { Oasis::Real(-8), Oasis::Variable("x") } },
+        Oasis::Real(15)
+    };
+    auto zeros = add.FindZeros();
+    REQUIRE(zeros.size() == 3);
+    std::set<double> goalSet = { 1.0, 5.0, -1.5 };
+    for (auto& i : zeros) {
+        double root;
+        if (auto divideCase = Oasis::RecursiveCast<Oasis::Divide<Oasis::Real>>(*i); divideCase != nullptr) {
+            root = divideCase->GetMostSigOp().GetValue() / divideCase->GetLeastSigOp().GetValue();
+        } else {
+            auto realCase = Oasis::RecursiveCast<Oasis::Real>(*i);
+            REQUIRE(realCase != nullptr);
+            root = realCase->GetValue();
+        }
+        REQUIRE(goalSet.contains(root));
+        goalSet.erase(root);
+    }
+}
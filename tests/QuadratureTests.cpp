@@ -0,0 +1,132 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <array>
+#include <cmath>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "Oasis/Compile.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Quadrature.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Variable.hpp"
+
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Definite Integral Without Antiderivative", "[Quadrature]")
+{
+    const Oasis::Variable x { "x" };
+
+    // e^(x^2) has no elementary antiderivative.
+    const Oasis::Exponent integrand { Oasis::EulerNumber {}, Oasis::Exponent { x, Oasis::Real { 2.0 } } };
+
+    const auto result = Oasis::EvaluateDefiniteIntegral(integrand, x, Oasis::Real { 0.0 }, Oasis::Real { 1.0 });
+    REQUIRE(result.has_value());
+    REQUIRE(result->converged);
+    REQUIRE(result->intervals > 0);
+    REQUIRE(result->error <= 1e-10);
+    REQUIRE_THAT(result->value, WithinAbs(1.4626517459071816, 1e-10));
+
+    const auto reversed = Oasis::EvaluateDefiniteIntegral(integrand, x, Oasis::Real { 1.0 }, Oasis::Real { 0.0 });
+    REQUIRE(reversed.has_value());
+    REQUIRE(reversed->value == -result->value);
+}
+
+TEST_CASE("Definite Integral With Antiderivative", "[Quadrature]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Exponent integrand { x, Oasis::Real { 2.0 } };
+
+    const auto result = Oasis::EvaluateDefiniteIntegral(integrand, x, Oasis::Real { 0.0 }, Oasis::Real { 2.0 });
+    REQUIRE(result.has_value());
+    REQUIRE(result->intervals == 0);
+    REQUIRE_THAT(result->value, WithinAbs(8.0 / 3.0, 1e-12));
+}
+
+TEST_CASE("Definite Integral Over A Variable Named C", "[Quadrature]")
+{
+    // C is also the name of the constant of integration, which must not be evaluated at the bounds.
+    const Oasis::Variable c { "C" };
+
+    const auto linear = Oasis::EvaluateDefiniteIntegral(c, c, Oasis::Real { 0.0 }, Oasis::Real { 1.0 });
+    REQUIRE(linear.has_value());
+    REQUIRE_THAT(linear->value, WithinAbs(0.5, 1e-12));
+
+    const auto square = Oasis::EvaluateDefiniteIntegral(Oasis::Exponent { c, Oasis::Real { 2.0 } }, c, Oasis::Real { 0.0 }, Oasis::Real { 3.0 });
+    REQUIRE(square.has_value());
+    REQUIRE(square->intervals == 0);
+    REQUIRE_THAT(square->value, WithinAbs(9.0, 1e-12));
+}
+
+TEST_CASE("Definite Integral Errors", "[Quadrature]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    REQUIRE(!Oasis::EvaluateDefiniteIntegral(x, x, Oasis::Real { 0.0 }, y).has_value());
+
+    const Oasis::Exponent integrand { Oasis::EulerNumber {}, Oasis::Multiply { x, y } };
+    REQUIRE(!Oasis::EvaluateDefiniteIntegral(integrand, x, Oasis::Real { 0.0 }, Oasis::Real { 1.0 }).has_value());
+}
+
+TEST_CASE("Quadrature Is Independent Of Thread Count", "[Quadrature]")
+{
+    const std::array variables { Oasis::Variable { "x" } };
+
+    // sin(100x)^2 oscillates too quickly for a coarse subdivision, so every subinterval is bisected
+    // until the batches are large enough to be split across threads.
+    const Oasis::Exponent integrand {
+        Oasis::Sine<Oasis::Expression> { Oasis::Multiply { Oasis::Real { 100.0 }, variables[0] } },
+        Oasis::Real { 2.0 }
+    };
+
+    const auto compiled = Oasis::Compile(integrand, variables);
+    REQUIRE(compiled.has_value());
+
+    const auto serial = Oasis::Quadrature(*compiled, 0.0, 3.0, { .threads = 1 });
+    const auto parallel = Oasis::Quadrature(*compiled, 0.0, 3.0, { .threads = 4 });
+
+    REQUIRE(serial.converged);
+    REQUIRE(serial.intervals >= 128);
+    REQUIRE_THAT(serial.value, WithinAbs(1.5 - std::sin(600.0) / 400.0, 1e-9));
+
+    REQUIRE(parallel.value == serial.value);
+    REQUIRE(parallel.error == serial.error);
+    REQUIRE(parallel.intervals == serial.intervals);
+}
+
+TEST_CASE("Quadrature Of Singular Integrand", "[Quadrature]")
+{
+    const std::array variables { Oasis::Variable { "x" } };
+
+    // x^(-1/2) is unbounded at 0, but its integral over [0, 1] is 2.
+    const auto compiled = Oasis::Compile(Oasis::Exponent { variables[0], Oasis::Real { -0.5 } }, variables);
+    REQUIRE(compiled.has_value());
+
+    const auto limited = Oasis::Quadrature(*compiled, 0.0, 1.0, { .maxIntervals = 8 });
+    REQUIRE(!limited.converged);
+    REQUIRE(limited.intervals == 8);
+
+    const auto result = Oasis::Quadrature(*compiled, 0.0, 1.0);
+    REQUIRE(result.converged);
+    REQUIRE_THAT(result.value, WithinAbs(2.0, 1e-8));
+}
+
+TEST_CASE("Definite Integral Across A Pole", "[Quadrature]")
+{
+    const Oasis::Variable x { "x" };
+
+    // x^-2 has the antiderivative -1/x, but its integral over [-1, 1] diverges at 0.
+    const Oasis::Exponent integrand { x, Oasis::Real { -2.0 } };
+
+    const auto result = Oasis::EvaluateDefiniteIntegral(integrand, x, Oasis::Real { -1.0 }, Oasis::Real { 1.0 });
+    REQUIRE(result.has_value());
+    REQUIRE(result->intervals > 0);
+    REQUIRE(!result->converged);
+}
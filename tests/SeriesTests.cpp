@@ -0,0 +1,98 @@
+//
+// Created by agent on 10/18/26.
+//
+
+#include <array>
+#include <cmath>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "Oasis/Compile.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/EulerNumber.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Series.hpp"
+#include "Oasis/Sine.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("Series Coefficients Of Elementary Functions", "[Series]")
+{
+    const Oasis::Variable x { "x" };
+
+    const auto exponential = Oasis::SeriesCoefficients(Oasis::Exponent { Oasis::EulerNumber {}, x }, x, 0.0, 10);
+    REQUIRE(exponential.has_value());
+    REQUIRE(exponential->size() == 11);
+    double factorial = 1.0;
+    for (std::size_t k = 0; k < exponential->size(); ++k) {
+        factorial *= k == 0 ? 1.0 : static_cast<double>(k);
+        REQUIRE_THAT((*exponential)[k], WithinRel(1.0 / factorial, 1e-14));
+    }
+
+    const auto logarithm = Oasis::SeriesCoefficients(Oasis::Log { Oasis::EulerNumber {}, x }, x, 1.0, 6);
+    REQUIRE(logarithm.has_value());
+    REQUIRE((*logarithm)[0] == 0.0);
+    for (std::size_t k = 1; k < logarithm->size(); ++k) {
+        REQUIRE_THAT((*logarithm)[k], WithinRel((k % 2 == 1 ? 1.0 : -1.0) / static_cast<double>(k), 1e-14));
+    }
+
+    const auto squareRoot = Oasis::SeriesCoefficients(Oasis::Exponent { x, Oasis::Real { 0.5 } }, x, 4.0, 2);
+    REQUIRE(squareRoot.has_value());
+    REQUIRE_THAT((*squareRoot)[0], WithinRel(2.0, 1e-15));
+    REQUIRE_THAT((*squareRoot)[1], WithinRel(0.25, 1e-15));
+    REQUIRE_THAT((*squareRoot)[2], WithinRel(-1.0 / 64.0, 1e-15));
+
+    const auto geometric = Oasis::SeriesCoefficients(Oasis::Divide { Oasis::Real { 1.0 }, Oasis::Subtract { Oasis::Real { 1.0 }, x } }, x, 0.0, 20);
+    REQUIRE(geometric.has_value());
+    for (const double coefficient : *geometric) {
+        REQUIRE(coefficient == 1.0);
+    }
+}
+
+TEST_CASE("Series Polynomial Approximates Expression", "[Series]")
+{
+    const std::array variables { Oasis::Variable { "x" } };
+    const auto& x = variables[0];
+
+    // x^x e^(sin(x)), which needs a variable exponent, a composition, and a product
+    const Oasis::Multiply expression {
+        Oasis::Exponent { x, x },
+        Oasis::Exponent { Oasis::EulerNumber {}, Oasis::Sine<Oasis::Expression> { x } }
+    };
+
+    const auto series = Oasis::Series(expression, x, Oasis::Real { 1.0 }, 16);
+    REQUIRE(series.has_value());
+
+    const auto polynomial = Oasis::Compile(**series, variables);
+    const auto exact = Oasis::Compile(expression, variables);
+    REQUIRE(polynomial.has_value());
+    REQUIRE(exact.has_value());
+
+    for (const double value : { 0.9, 1.0, 1.05, 1.1 }) {
+        const std::array arguments { value };
+        REQUIRE_THAT((*polynomial)(arguments), WithinAbs((*exact)(arguments), 1e-12));
+    }
+
+    const auto constant = Oasis::Series(Oasis::Real { 0.0 }, x, Oasis::Real { 0.0 }, 4);
+    REQUIRE(constant.has_value());
+    REQUIRE((*constant)->Is<Oasis::Real>());
+}
+
+TEST_CASE("Series Errors", "[Series]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    REQUIRE(!Oasis::SeriesCoefficients(Oasis::Log { Oasis::EulerNumber {}, x }, x, 0.0, 4).has_value());
+    REQUIRE(!Oasis::SeriesCoefficients(Oasis::Divide { Oasis::Real { 1.0 }, x }, x, 0.0, 4).has_value());
+    REQUIRE(!Oasis::SeriesCoefficients(Oasis::Exponent { x, Oasis::Real { 0.5 } }, x, 0.0, 4).has_value());
+    REQUIRE(!Oasis::SeriesCoefficients(Oasis::Multiply { x, y }, x, 0.0, 4).has_value());
+    REQUIRE(!Oasis::Series(x, x, y, 4).has_value());
+}
@@ -2,11 +2,15 @@
 // Created by Matthew McCall on 4/30/24.
 //
 
+#include <stdexcept>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include <Oasis/Add.hpp>
 #include <Oasis/Multiply.hpp>
 #include <Oasis/Negate.hpp>
+#include <Oasis/Real.hpp>
+#include <Oasis/Sine.hpp>
 #include <Oasis/Variable.hpp>
 
 TEST_CASE("Substitute Unary", "[Substitute]")
@@ -22,4 +26,23 @@ TEST_CASE("Substitute Unary", "[Substitute]")
 
     const auto after = before.Substitute(Oasis::Variable { "x" }, Oasis::Real { 4.0 }); // after should some std::unique_ptr<Expression> such that it equals 2(-4) + 3(4)
     REQUIRE(after->Equals(Oasis::Real { 4 }));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Substitute Unary Simplifies", "[Substitute]")
+{
+    Oasis::Negate before { Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } } }; // -(x+1)
+
+    // the negation itself is simplified, not only its operand
+    const auto after = before.Substitute(Oasis::Variable { "x" }, Oasis::Real { 2.0 });
+    REQUIRE(after->Equals(Oasis::Real { -3.0 }));
+}
+
+TEST_CASE("Substitute Unary Requires A Variable", "[Substitute]")
+{
+    Oasis::Negate withVariable { Oasis::Variable { "x" } };
+    REQUIRE_THROWS_AS(withVariable.Substitute(Oasis::Real { 1.0 }, Oasis::Real { 2.0 }), std::invalid_argument);
+
+    // even when there is nothing to substitute
+    Oasis::Sine<Oasis::Expression> withoutVariable { Oasis::Real { 1.0 } };
+    REQUIRE_THROWS_AS(withoutVariable.Substitute(Oasis::Real { 1.0 }, Oasis::Real { 2.0 }), std::invalid_argument);
+}